@@ -0,0 +1,145 @@
+#define _GNU_SOURCE
+
+#include "bench.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+volatile unsigned int bench_sink = 0;
+
+void bench_default_options(bench_options *options) {
+  options->samples = 200;
+  options->warmup_ms = 20.0;
+  options->sample_us = 50.0;
+  options->cpu = 0;
+  options->filter = NULL;
+  options->matrix = 0;
+  options->matrix_reps = 7;
+  options->matrix_batch = 8;
+  options->csv_path = NULL;
+  options->json_path = NULL;
+  options->repeat = 1;
+  options->commit = NULL;
+  options->flags = NULL;
+  options->baseline_path = NULL;
+  options->current_path = NULL;
+  options->threshold = 5.0;
+  options->atomic = 0;
+  options->atomic_ops = 100000;
+  options->parallel = 0;
+  options->parallel_count = 4000000;
+  options->group = 0;
+}
+
+// Монотонное время в наносекундах
+uint64_t bench_now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// Счетчик тактов: rdtsc на x86 (опорная частота), иначе наносекунды
+uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return bench_now_ns();
+#endif
+}
+
+// Привязка процесса к ядру cpu, чтобы замеры не прыгали между ядрами
+int bench_pin_cpu(int cpu) {
+  int status = 0;
+  if (cpu >= 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    status = sched_setaffinity(0, sizeof(set), &set);
+  }
+  return status;
+}
+
+// Генератор xorshift64*: воспроизводимые входные данные без rand()
+uint64_t bench_random(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int compare_double(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Перцентиль p (0..100) отсортированного массива
+static double percentile(const double *sorted, int count, double p) {
+  int index = (int)(p / 100.0 * (count - 1) + 0.5);
+  return sorted[index];
+}
+
+// Прогрев и подбор batch: batch удваивается, пока один замер не станет
+// длиннее sample_us, а прогрев продолжается не меньше warmup_ms
+static size_t calibrate(bench_body body, const void *context,
+                        const bench_options *options) {
+  size_t batch = 1;
+  uint64_t target = (uint64_t)(options->sample_us * 1000.0);
+  uint64_t warmup = (uint64_t)(options->warmup_ms * 1000000.0);
+  uint64_t start = bench_now_ns();
+  int calibrated = 0;
+  while (!calibrated || bench_now_ns() - start < warmup) {
+    uint64_t begin = bench_now_ns();
+    body(context, batch);
+    uint64_t elapsed = bench_now_ns() - begin;
+    if (elapsed < target && !calibrated) {
+      batch *= 2;
+    } else {
+      calibrated = 1;
+    }
+  }
+  return batch;
+}
+
+void bench_measure(bench_body body, const void *context,
+                   const bench_options *options, bench_stats *stats) {
+  int samples = (options->samples > 0) ? options->samples : 1;
+  double *times = malloc(sizeof(double) * samples);
+  size_t batch = calibrate(body, context, options);
+  double total = 0.0;
+
+  for (int i = 0; times && i < samples; i++) {
+    uint64_t begin = bench_now_ns();
+    body(context, batch);
+    times[i] = (double)(bench_now_ns() - begin) / (double)batch;
+    total += times[i];
+  }
+
+  if (times) {
+    qsort(times, samples, sizeof(double), compare_double);
+    stats->mean_ns = total / samples;
+    stats->min_ns = times[0];
+    stats->p50_ns = percentile(times, samples, 50.0);
+    stats->p90_ns = percentile(times, samples, 90.0);
+    stats->p99_ns = percentile(times, samples, 99.0);
+    stats->max_ns = times[samples - 1];
+    stats->ops_per_sec = (stats->mean_ns > 0) ? 1e9 / stats->mean_ns : 0.0;
+  }
+  stats->batch = batch;
+  free(times);
+}
+
+void bench_print_header(FILE *out) {
+  fprintf(out, "%-26s %-14s %10s %14s %10s %10s %10s\n", "function",
+          "dataset", "ns/op", "ops/s", "p50", "p90", "p99");
+}
+
+void bench_print_row(FILE *out, const char *name, const char *dataset,
+                     const bench_stats *stats) {
+  fprintf(out, "%-26s %-14s %10.2f %14.0f %10.2f %10.2f %10.2f\n", name,
+          dataset, stats->mean_ns, stats->ops_per_sec, stats->p50_ns,
+          stats->p90_ns, stats->p99_ns);
+}
@@ -0,0 +1,115 @@
+#ifndef S21_BENCH_H
+#define S21_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../src/s21_decimal.h"
+
+// Настройки измерения
+typedef struct {
+  int samples;         // количество замеров на один случай
+  double warmup_ms;    // прогрев перед замерами
+  double sample_us;    // целевая длительность одного замера
+  int cpu;             // ядро для привязки (-1 - без привязки)
+  const char *filter;  // подстрока имени функции (NULL - все)
+  int matrix;          // режим матрицы scale 29x29 вместо обычного прогона
+  int matrix_reps;     // замеров на ячейку матрицы (берется медиана)
+  int matrix_batch;    // вызовов в одном замере ячейки
+  const char *csv_path;   // CSV матрицы (NULL - не писать)
+  const char *json_path;  // JSON прогона или матрицы (NULL - не писать)
+  int repeat;             // повторов всего прогона (для интервалов)
+  const char *commit;     // метаданные прогона для JSON
+  const char *flags;
+  const char *baseline_path;  // режим сравнения: базовый и текущий JSON
+  const char *current_path;
+  double threshold;  // допустимое замедление в процентах
+  int atomic;        // режим конкуренции за s21_atomic_decimal
+  int atomic_ops;    // сложений на поток в этом режиме
+  int parallel;      // режим параллельных пакетных функций
+  size_t parallel_count;  // элементов в массиве этого режима
+  int group;              // режим группировки (строк - parallel_count)
+} bench_options;
+
+// Результат одного случая, время - наносекунды на вызов. Перцентили
+// считаются по замерам, каждый замер - среднее по batch вызовам
+typedef struct {
+  double mean_ns;
+  double min_ns;
+  double p50_ns;
+  double p90_ns;
+  double p99_ns;
+  double max_ns;
+  double ops_per_sec;
+  size_t batch;
+} bench_stats;
+
+// История прогонов: среднее время каждого повтора для пары функция/набор
+#define BENCH_MAX_RECORDS 256
+#define BENCH_MAX_RUNS 32
+
+typedef struct {
+  char function[48];
+  char dataset[24];
+  int runs;
+  double mean_ns[BENCH_MAX_RUNS];
+} bench_record;
+
+typedef struct {
+  char commit[64];
+  char compiler[128];
+  char flags[256];
+  char cpu[128];
+  char date[32];
+  int count;
+  bench_record records[BENCH_MAX_RECORDS];
+} bench_report;
+
+// Тело замера: count вызовов измеряемой функции
+typedef void (*bench_body)(const void *context, size_t count);
+
+// Результат измеряемых вызовов складывается сюда, чтобы компилятор не
+// выбросил их
+extern volatile unsigned int bench_sink;
+
+void bench_default_options(bench_options *options);
+uint64_t bench_now_ns(void);
+uint64_t bench_cycles(void);
+int bench_pin_cpu(int cpu);
+uint64_t bench_random(uint64_t *state);
+void bench_measure(bench_body body, const void *context,
+                   const bench_options *options, bench_stats *stats);
+void bench_print_header(FILE *out);
+void bench_print_row(FILE *out, const char *name, const char *dataset,
+                     const bench_stats *stats);
+
+// Прогоны в JSON и их сравнение (bench_report.c). bench_compare
+// возвращает 0, 1 при значимом (по 95% интервалу) замедлении больше
+// threshold процентов и 2 при ошибке; результаты меньше чем из двух
+// повторов не проверяются и только дают предупреждение
+void bench_report_init(bench_report *report, const char *commit,
+                       const char *flags);
+bench_record *bench_report_record(bench_report *report, const char *function,
+                                  const char *dataset);
+int bench_report_write(const bench_report *report, const char *path);
+int bench_report_read(bench_report *report, const char *path);
+int bench_compare(const char *baseline_path, const char *current_path,
+                  double threshold);
+
+// Матрица scale: задержка s21_add, s21_mul, s21_div и сравнений для всех
+// пар scale 0..28 и набора неудобных мантисс (bench_matrix.c)
+int bench_matrix_run(const bench_options *options);
+
+// Конкуренция потоков за один итог на 1-64 потоках: s21_atomic_add,
+// s21_add под мьютексом и s21_sharded_add (bench_atomic.c)
+int bench_atomic_run(const bench_options *options);
+
+// Пакетные функции на пуле потоков против последовательного s21_add по
+// массиву из parallel_count элементов (bench_parallel.c)
+int bench_parallel_run(const bench_options *options);
+// s21_group_by_i64 по parallel_count строкам при 10-10^7 разных ключей:
+// последовательно и с разбиением на разделы (bench_group.c)
+int bench_group_run(const bench_options *options);
+
+#endif
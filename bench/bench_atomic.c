@@ -0,0 +1,144 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Способы сложения в общий итог
+typedef enum {
+  MODE_CAS,        // s21_atomic_add, слагаемые с тем же scale (быстрый путь)
+  MODE_CAS_MIXED,  // s21_atomic_add, scale слагаемых чередуется
+  MODE_MUTEX,      // s21_add под общим мьютексом
+  MODE_SHARDED,    // s21_sharded_add, у каждого потока свой слот
+  MODE_COUNT
+} atomic_mode;
+
+static const char *mode_names[MODE_COUNT] = {"atomic_cas", "atomic_mixed",
+                                             "mutex", "sharded"};
+
+typedef struct {
+  atomic_mode mode;
+  int ops;
+  size_t shard;
+  s21_atomic_decimal *total;
+  s21_sharded_sum *sharded;
+  s21_decimal *locked_total;
+  pthread_mutex_t *mutex;
+  pthread_barrier_t *start;
+} atomic_worker;
+
+// 0.01 и 0.001: при чередовании scale итог переходит на scale 3, и каждое
+// второе слагаемое требует выравнивания
+static s21_decimal addend(atomic_mode mode, int i) {
+  s21_decimal value = {{1, 0, 0, 2u << 16}};
+  if (mode == MODE_CAS_MIXED && (i & 1)) value.bits[3] = 3u << 16;
+  return value;
+}
+
+static void *worker_main(void *argument) {
+  atomic_worker *worker = argument;
+  pthread_barrier_wait(worker->start);
+  for (int i = 0; i < worker->ops; i++) {
+    s21_decimal value = addend(worker->mode, i);
+    if (worker->mode == MODE_MUTEX) {
+      pthread_mutex_lock(worker->mutex);
+      s21_add(*worker->locked_total, value, worker->locked_total);
+      pthread_mutex_unlock(worker->mutex);
+    } else if (worker->mode == MODE_SHARDED) {
+      s21_sharded_add(worker->sharded, worker->shard, value);
+    } else {
+      s21_atomic_add(worker->total, value);
+    }
+  }
+  return NULL;
+}
+
+// Ожидаемый итог: threads потоков по ops слагаемых
+static s21_decimal expected_total(atomic_mode mode, int threads, int ops) {
+  s21_decimal sum = {{0}};
+  s21_decimal count = {{0}};
+  s21_decimal part = {{0}};
+  for (int parity = 0; parity < 2; parity++) {
+    int per_thread = (mode == MODE_CAS_MIXED) ? (ops + 1 - parity) / 2
+                                              : (parity ? 0 : ops);
+    s21_from_int_to_decimal(per_thread * threads, &count);
+    s21_mul(addend(mode, parity), count, &part);
+    s21_add(sum, part, &sum);
+  }
+  return sum;
+}
+
+// Один прогон: threads потоков одновременно добавляют ops слагаемых.
+// Возвращает наносекунды на сложение (по стене) или -1 при ошибке
+static double run_mode(atomic_mode mode, int threads, int ops, int *exact) {
+  pthread_t *ids = malloc(sizeof(pthread_t) * threads);
+  atomic_worker *workers = malloc(sizeof(atomic_worker) * threads);
+  s21_atomic_decimal total;
+  s21_decimal locked_total = {{0}};
+  s21_sharded_sum sharded = {NULL, 0};
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+  pthread_barrier_t start;
+  double result = -1.0;
+
+  if (ids && workers &&
+      s21_sharded_init(&sharded, (size_t)threads) == CodeOK &&
+      !pthread_barrier_init(&start, NULL, threads + 1)) {
+    s21_atomic_init(&total, locked_total);
+    int created = 0;
+    for (int t = 0; t < threads; t++) {
+      atomic_worker worker = {mode,     ops,           (size_t)t, &total,
+                              &sharded, &locked_total, &mutex,    &start};
+      workers[t] = worker;
+      created += !pthread_create(&ids[t], NULL, worker_main, &workers[t]);
+    }
+    if (created == threads) {
+      uint64_t begin = bench_now_ns();
+      pthread_barrier_wait(&start);
+      for (int t = 0; t < threads; t++) pthread_join(ids[t], NULL);
+      uint64_t elapsed = bench_now_ns() - begin;
+      result = (double)elapsed / ((double)threads * ops);
+
+      s21_decimal got = s21_atomic_load(&total);
+      if (mode == MODE_MUTEX) got = locked_total;
+      if (mode == MODE_SHARDED) {
+        s21_sharded_read(&sharded, S21_ROUND_HALF_EVEN, &got);
+      }
+      *exact = s21_is_equal(got, expected_total(mode, threads, ops));
+    }
+    pthread_barrier_destroy(&start);
+  }
+  s21_sharded_free(&sharded);
+  free(ids);
+  free(workers);
+  return result;
+}
+
+int bench_atomic_run(const bench_options *options) {
+  static const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+  int ops = (options->atomic_ops > 0) ? options->atomic_ops : 1;
+  int status = 0;
+  printf("%-14s %8s %12s %14s %6s\n", "mode", "threads", "ns/add",
+         "adds/s", "exact");
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(int); i++) {
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+      if (options->filter && !strstr(mode_names[mode], options->filter)) {
+        continue;
+      }
+      int exact = 0;
+      double ns = run_mode((atomic_mode)mode, thread_counts[i], ops, &exact);
+      if (ns < 0) {
+        fprintf(stderr, "bench: could not start %d threads\n",
+                thread_counts[i]);
+        status = 1;
+      } else {
+        printf("%-14s %8d %12.2f %14.0f %6s\n", mode_names[mode],
+               thread_counts[i], ns, ns > 0 ? 1e9 / ns : 0.0,
+               exact ? "yes" : "NO");
+        if (!exact) status = 1;
+      }
+    }
+  }
+  return status;
+}
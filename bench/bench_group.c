@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Группы совпадают побитно: ключи, количества, первые строки, min, max и
+// суммы (вместе с кодом чтения)
+static int same_groups(const s21_group_table *a, const s21_group_table *b) {
+  int same = a->count == b->count;
+  for (size_t i = 0; same && i < a->count; i++) {
+    const s21_group *x = &a->groups[i];
+    const s21_group *y = &b->groups[i];
+    s21_decimal sum_x = {{0}};
+    s21_decimal sum_y = {{0}};
+    int code_x = s21_group_sum(x, &sum_x);
+    int code_y = s21_group_sum(y, &sum_y);
+    same = !memcmp(&x->key, &y->key, sizeof(s21_decimal)) &&
+           x->count == y->count && x->first == y->first &&
+           !memcmp(&x->min, &y->min, sizeof(s21_decimal)) &&
+           !memcmp(&x->max, &y->max, sizeof(s21_decimal)) &&
+           code_x == code_y && !memcmp(&sum_x, &sum_y, sizeof(s21_decimal));
+  }
+  return same;
+}
+
+// Прогон при одном числе ключей: NULL-политика (одна таблица на все строки)
+// и разбиение на разделы на встроенном пуле с 1-16 участниками
+static int run_cardinality(const int64_t *keys, const s21_decimal *values,
+                           size_t n, size_t cardinality) {
+  static const int thread_counts[] = {1, 2, 4, 8, 16};
+  s21_group_table first = {NULL, 0};
+  int status = 0;
+  uint64_t begin = bench_now_ns();
+  int first_code = s21_group_by_i64(keys, values, n, &first, NULL);
+  double first_ms = (double)(bench_now_ns() - begin) / 1e6;
+  printf("%12zu %8s %10.2f %10.2f %10zu %6s %5d\n", cardinality, "seq",
+         first_ms, (double)n / first_ms / 1e3, first.count, "-", first_code);
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(int); i++) {
+    s21_group_table table = {NULL, 0};
+    s21_exec_policy policy = {S21_EXEC_PARALLEL, thread_counts[i], NULL};
+    begin = bench_now_ns();
+    int code = s21_group_by_i64(keys, values, n, &table, &policy);
+    double ms = (double)(bench_now_ns() - begin) / 1e6;
+    int same = code == first_code && same_groups(&first, &table);
+    printf("%12zu %8d %10.2f %10.2f %10zu %6s %5d\n", cardinality,
+           thread_counts[i], ms, (double)n / ms / 1e3, table.count,
+           same ? "yes" : "NO", code);
+    if (!same) status = 1;
+    s21_group_table_free(&table);
+  }
+  s21_group_table_free(&first);
+  return status;
+}
+
+int bench_group_run(const bench_options *options) {
+  size_t n = options->parallel_count ? options->parallel_count : 1;
+  int64_t *keys = malloc(sizeof(int64_t) * n);
+  s21_decimal *values = malloc(sizeof(s21_decimal) * n);
+  int status = 0;
+  if (!keys || !values) {
+    fprintf(stderr, "bench: could not allocate %zu rows\n", n);
+    status = 1;
+  } else {
+    s21_workload workload;
+    s21_workload_init(&workload, 42);
+    s21_workload_fill(&workload, S21_WORKLOAD_PNL, values, n);
+    printf("%zu rows, %d cpus\n", n, s21_pool_default_threads());
+    printf("%12s %8s %10s %10s %10s %6s %5s\n", "keys", "threads", "ms",
+           "Mrows/s", "groups", "same", "code");
+    for (size_t cardinality = 10; cardinality <= 10000000;
+         cardinality *= 10) {
+      uint64_t state = 7;
+      for (size_t i = 0; i < n; i++) {
+        keys[i] = (int64_t)(bench_random(&state) % cardinality);
+      }
+      status |= run_cardinality(keys, values, n, cardinality);
+    }
+  }
+  s21_pool_shutdown();
+  free(keys);
+  free(values);
+  return status;
+}
@@ -0,0 +1,557 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Размер набора входных данных (степень двойки: индекс берется по маске)
+#define BENCH_INPUTS 1024
+#define BENCH_MASK (BENCH_INPUTS - 1)
+
+// Наборы входных данных
+enum {
+  DS_SMALL_EQUAL = 1 << 0,  // мантиссы до 10^6, одинаковый scale
+  DS_SMALL_MIXED = 1 << 1,  // мантиссы до 10^6, scale 0..28
+  DS_FULL_EQUAL = 1 << 2,   // 96-битные мантиссы, одинаковый scale
+  DS_FULL_MIXED = 1 << 3,   // 96-битные мантиссы, scale 0..28
+  DS_OVERFLOW = 1 << 4,     // мантиссы у границы 2^96, переполнения
+  DS_UNIT = 1 << 5,         // значения из (0, 10) для exp, ln, sqrt
+  DS_WORKLOAD = 1 << 6,     // смешанный поток из генератора нагрузки
+  DS_COUNT = 7
+};
+
+#define DS_BINARY                                                \
+  (DS_SMALL_EQUAL | DS_SMALL_MIXED | DS_FULL_EQUAL | DS_FULL_MIXED | \
+   DS_OVERFLOW | DS_WORKLOAD)
+#define DS_UNARY (DS_SMALL_MIXED | DS_FULL_MIXED | DS_WORKLOAD)
+#define DS_ACCUMULATE (DS_SMALL_EQUAL | DS_SMALL_MIXED | DS_WORKLOAD)
+
+typedef struct {
+  const char *name;
+  s21_decimal a[BENCH_INPUTS];
+  s21_decimal b[BENCH_INPUTS];
+  int64_t numbers[BENCH_INPUTS];
+  int ints[BENCH_INPUTS];
+  float floats[BENCH_INPUTS];
+  s21_trace_op trace[BENCH_INPUTS];
+} bench_dataset;
+
+static bench_dataset datasets[DS_COUNT];
+
+// Виды измеряемых функций
+typedef enum {
+  KIND_BINARY,
+  KIND_COMPARE,
+  KIND_UNARY,
+  KIND_I64,
+  KIND_RESCALE,
+  KIND_POW,
+  KIND_FROM_INT,
+  KIND_FROM_FLOAT,
+  KIND_TO_INT,
+  KIND_TO_FLOAT,
+  KIND_TRACE,
+  KIND_ACCUMULATE,  // sum = op(sum, a[i]) через функцию по значению
+  KIND_ASSIGN,      // то же через s21_add_assign
+  KIND_REF,         // бинарная операция по указателям (s21_*_ref)
+  KIND_DIGITS,      // число цифр мантиссы
+  KIND_COMPOUND,    // сложный процент по compound_rates/compound_periods
+  KIND_BATCH,       // пакетная функция: время на элемент
+} bench_kind;
+
+// Пакетная функция на первых n элементах набора (n <= BENCH_INPUTS),
+// policy NULL: пакет считается в вызывающем потоке
+typedef int (*bench_batch)(const bench_dataset *data, size_t n,
+                           s21_decimal *out);
+
+// Ставки и сроки для s21_compound: 0.01..0.10 на 1..30 периодов
+static s21_decimal compound_rates[BENCH_INPUTS];
+static int compound_periods[BENCH_INPUTS];
+
+static int batch_add_i64(const bench_dataset *data, size_t n,
+                         s21_decimal *out) {
+  return s21_add_i64_n(data->a, data->numbers, out, NULL, n, NULL);
+}
+
+static int batch_sub_i64(const bench_dataset *data, size_t n,
+                         s21_decimal *out) {
+  return s21_sub_i64_n(data->a, data->numbers, out, NULL, n, NULL);
+}
+
+static int batch_mul_i64(const bench_dataset *data, size_t n,
+                         s21_decimal *out) {
+  return s21_mul_i64_n(data->a, data->numbers, out, NULL, n, NULL);
+}
+
+static int batch_div_i64(const bench_dataset *data, size_t n,
+                         s21_decimal *out) {
+  return s21_div_i64_n(data->a, data->numbers, out, NULL, n, NULL);
+}
+
+static int batch_quantize(const bench_dataset *data, size_t n,
+                          s21_decimal *out) {
+  return s21_quantize_n(data->a, out, n, 2, S21_ROUND_HALF_EVEN, NULL, NULL);
+}
+
+static int batch_compound(const bench_dataset *data, size_t n,
+                          s21_decimal *out) {
+  return s21_compound_n(data->a, compound_rates, compound_periods, out, NULL,
+                        n, NULL);
+}
+
+static int batch_sqrt(const bench_dataset *data, size_t n, s21_decimal *out) {
+  return s21_sqrt_n(data->a, out, NULL, n, NULL);
+}
+
+static int batch_exp(const bench_dataset *data, size_t n, s21_decimal *out) {
+  return s21_exp_n(data->a, out, NULL, n, NULL);
+}
+
+static int batch_ln(const bench_dataset *data, size_t n, s21_decimal *out) {
+  return s21_ln_n(data->a, out, NULL, n, NULL);
+}
+
+static int batch_log10(const bench_dataset *data, size_t n,
+                       s21_decimal *out) {
+  return s21_log10_n(data->a, out, NULL, n, NULL);
+}
+
+typedef struct {
+  const char *name;
+  bench_kind kind;
+  int datasets;
+  int (*binary)(s21_decimal, s21_decimal, s21_decimal *);
+  int (*compare)(s21_decimal, s21_decimal);
+  int (*unary)(s21_decimal, s21_decimal *);
+  int (*with_i64)(s21_decimal, int64_t, s21_decimal *);
+  int (*ref)(const s21_decimal *, const s21_decimal *, s21_decimal *);
+  int (*digits)(s21_decimal);
+  bench_batch batch;
+} bench_case;
+
+static const bench_case cases[] = {
+    {"s21_add", KIND_BINARY, DS_BINARY, s21_add, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_sub", KIND_BINARY, DS_BINARY, s21_sub, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_mul", KIND_BINARY, DS_BINARY, s21_mul, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_div", KIND_BINARY, DS_BINARY, s21_div, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_add_ref", KIND_REF, DS_BINARY, NULL, NULL, NULL, NULL, s21_add_ref,
+     NULL, NULL},
+    {"s21_sub_ref", KIND_REF, DS_BINARY, NULL, NULL, NULL, NULL, s21_sub_ref,
+     NULL, NULL},
+    {"s21_mul_ref", KIND_REF, DS_BINARY, NULL, NULL, NULL, NULL, s21_mul_ref,
+     NULL, NULL},
+    {"s21_div_ref", KIND_REF, DS_BINARY, NULL, NULL, NULL, NULL, s21_div_ref,
+     NULL, NULL},
+    {"s21_is_less", KIND_COMPARE, DS_BINARY, NULL, s21_is_less, NULL, NULL,
+     NULL, NULL, NULL},
+    {"s21_is_less_or_equal", KIND_COMPARE, DS_BINARY, NULL,
+     s21_is_less_or_equal, NULL, NULL, NULL, NULL, NULL},
+    {"s21_is_greater", KIND_COMPARE, DS_BINARY, NULL, s21_is_greater, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_is_greater_or_equal", KIND_COMPARE, DS_BINARY, NULL,
+     s21_is_greater_or_equal, NULL, NULL, NULL, NULL, NULL},
+    {"s21_is_equal", KIND_COMPARE, DS_BINARY, NULL, s21_is_equal, NULL, NULL,
+     NULL, NULL, NULL},
+    {"s21_is_not_equal", KIND_COMPARE, DS_BINARY, NULL, s21_is_not_equal, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_add_i64", KIND_I64, DS_UNARY, NULL, NULL, NULL, s21_add_i64, NULL,
+     NULL, NULL},
+    {"s21_sub_i64", KIND_I64, DS_UNARY, NULL, NULL, NULL, s21_sub_i64, NULL,
+     NULL, NULL},
+    {"s21_mul_i64", KIND_I64, DS_UNARY, NULL, NULL, NULL, s21_mul_i64, NULL,
+     NULL, NULL},
+    {"s21_div_i64", KIND_I64, DS_UNARY, NULL, NULL, NULL, s21_div_i64, NULL,
+     NULL, NULL},
+    {"s21_add_i64_n", KIND_BATCH, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_add_i64},
+    {"s21_sub_i64_n", KIND_BATCH, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_sub_i64},
+    {"s21_mul_i64_n", KIND_BATCH, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_mul_i64},
+    {"s21_div_i64_n", KIND_BATCH, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_div_i64},
+    {"s21_from_int_to_decimal", KIND_FROM_INT, DS_SMALL_EQUAL, NULL, NULL, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_from_float_to_decimal", KIND_FROM_FLOAT, DS_UNARY, NULL, NULL, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_from_decimal_to_int", KIND_TO_INT, DS_UNARY, NULL, NULL, NULL, NULL,
+     NULL, NULL, NULL},
+    {"s21_from_decimal_to_float", KIND_TO_FLOAT, DS_UNARY, NULL, NULL, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_floor", KIND_UNARY, DS_UNARY, NULL, NULL, s21_floor, NULL, NULL, NULL,
+     NULL},
+    {"s21_round", KIND_UNARY, DS_UNARY, NULL, NULL, s21_round, NULL, NULL, NULL,
+     NULL},
+    {"s21_truncate", KIND_UNARY, DS_UNARY, NULL, NULL, s21_truncate, NULL, NULL,
+     NULL, NULL},
+    {"s21_negate", KIND_UNARY, DS_UNARY, NULL, NULL, s21_negate, NULL, NULL,
+     NULL, NULL},
+    {"s21_ceil", KIND_UNARY, DS_UNARY, NULL, NULL, s21_ceil, NULL, NULL, NULL,
+     NULL},
+    {"s21_rescale", KIND_RESCALE, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_quantize_n", KIND_BATCH, DS_UNARY, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_quantize},
+    {"s21_digit_count", KIND_DIGITS, DS_UNARY, NULL, NULL, NULL, NULL, NULL,
+     s21_digit_count, NULL},
+    {"s21_trailing_zeros", KIND_DIGITS, DS_UNARY, NULL, NULL, NULL, NULL, NULL,
+     s21_trailing_zeros, NULL},
+    {"s21_pow_int", KIND_POW, DS_UNIT, NULL, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_compound", KIND_COMPOUND, DS_UNIT, NULL, NULL, NULL, NULL, NULL, NULL,
+     NULL},
+    {"s21_compound_n", KIND_BATCH, DS_UNIT, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_compound},
+    {"s21_sqrt", KIND_UNARY, DS_UNIT | DS_FULL_MIXED, NULL, NULL, s21_sqrt,
+     NULL, NULL, NULL, NULL},
+    {"s21_exp", KIND_UNARY, DS_UNIT, NULL, NULL, s21_exp, NULL, NULL, NULL,
+     NULL},
+    {"s21_ln", KIND_UNARY, DS_UNIT | DS_FULL_MIXED, NULL, NULL, s21_ln, NULL,
+     NULL, NULL, NULL},
+    {"s21_log10", KIND_UNARY, DS_UNIT | DS_FULL_MIXED, NULL, NULL, s21_log10,
+     NULL, NULL, NULL, NULL},
+    {"s21_sqrt_n", KIND_BATCH, DS_UNIT | DS_FULL_MIXED, NULL, NULL, NULL, NULL,
+     NULL, NULL, batch_sqrt},
+    {"s21_exp_n", KIND_BATCH, DS_UNIT, NULL, NULL, NULL, NULL, NULL, NULL,
+     batch_exp},
+    {"s21_ln_n", KIND_BATCH, DS_UNIT | DS_FULL_MIXED, NULL, NULL, NULL, NULL,
+     NULL, NULL, batch_ln},
+    {"s21_log10_n", KIND_BATCH, DS_UNIT | DS_FULL_MIXED, NULL, NULL, NULL, NULL,
+     NULL, NULL, batch_log10},
+    {"s21_trace_replay", KIND_TRACE, DS_WORKLOAD, NULL, NULL, NULL, NULL, NULL,
+     NULL, NULL},
+    // Цикл накопления: версия по значению и на месте
+    {"s21_add_accumulate", KIND_ACCUMULATE, DS_ACCUMULATE, s21_add, NULL, NULL,
+     NULL, NULL, NULL, NULL},
+    {"s21_add_assign", KIND_ASSIGN, DS_ACCUMULATE, NULL, NULL, NULL, NULL, NULL,
+     NULL, NULL},
+};
+
+// Что измеряется в одном замере: функция и набор данных
+typedef struct {
+  const bench_case *test;
+  const bench_dataset *data;
+} bench_job;
+
+// Пакетная функция: count элементов кусками по BENCH_INPUTS, чтобы время
+// делилось на число элементов так же, как у скалярных функций
+static void run_batch(const bench_job *job, size_t count) {
+  static s21_decimal out[BENCH_INPUTS];
+  unsigned int acc = 0;
+  for (size_t done = 0; done < count;) {
+    size_t n = count - done;
+    if (n > BENCH_INPUTS) n = BENCH_INPUTS;
+    acc += (unsigned int)job->test->batch(job->data, n, out);
+    acc += out[n - 1].bits[0];
+    done += n;
+  }
+  bench_sink += acc;
+}
+
+static void run_job(const void *context, size_t count) {
+  const bench_job *job = context;
+  if (job->test->kind == KIND_BATCH) {
+    run_batch(job, count);
+    return;
+  }
+  const bench_dataset *data = job->data;
+  s21_decimal result = {{0}};
+  s21_decimal sum = {{0}};
+  unsigned int acc = 0;
+  for (size_t i = 0; i < count; i++) {
+    size_t k = i & BENCH_MASK;
+    switch (job->test->kind) {
+      case KIND_BINARY:
+        acc += job->test->binary(data->a[k], data->b[k], &result);
+        break;
+      case KIND_COMPARE:
+        acc += job->test->compare(data->a[k], data->b[k]);
+        break;
+      case KIND_UNARY:
+        acc += job->test->unary(data->a[k], &result);
+        break;
+      case KIND_I64:
+        acc += job->test->with_i64(data->a[k], data->numbers[k], &result);
+        break;
+      case KIND_RESCALE:
+        acc += s21_rescale(data->a[k], 2, S21_ROUND_HALF_EVEN, &result);
+        break;
+      case KIND_POW:
+        acc += s21_pow_int(data->a[k], 12, &result);
+        break;
+      case KIND_FROM_INT:
+        acc += s21_from_int_to_decimal(data->ints[k], &result);
+        break;
+      case KIND_FROM_FLOAT:
+        acc += s21_from_float_to_decimal(data->floats[k], &result);
+        break;
+      case KIND_TO_INT: {
+        int number = 0;
+        acc += s21_from_decimal_to_int(data->a[k], &number);
+        acc += (unsigned int)number;
+      } break;
+      case KIND_TO_FLOAT: {
+        float number = 0;
+        acc += s21_from_decimal_to_float(data->a[k], &number);
+        acc += (unsigned int)(number != 0);
+      } break;
+      case KIND_TRACE:
+        acc += s21_trace_replay(&data->trace[k], 1, &result, NULL);
+        break;
+      case KIND_ACCUMULATE:
+        // При переполнении сумма обнуляется, как и в версии на месте
+        if (job->test->binary(sum, data->a[k], &sum) != CodeOK) {
+          sum = (s21_decimal){{0}};
+        }
+        break;
+      case KIND_ASSIGN:
+        if (s21_add_assign(&sum, &data->a[k]) != CodeOK) {
+          sum = (s21_decimal){{0}};
+        }
+        break;
+      case KIND_REF:
+        acc += job->test->ref(&data->a[k], &data->b[k], &result);
+        break;
+      case KIND_DIGITS:
+        acc += (unsigned int)job->test->digits(data->a[k]);
+        break;
+      case KIND_COMPOUND:
+        acc += s21_compound(data->a[k], compound_rates[k],
+                            compound_periods[k], &result);
+        break;
+      case KIND_BATCH:  // измеряется в run_batch
+        break;
+    }
+    acc += result.bits[0];
+  }
+  bench_sink += acc + sum.bits[0];
+}
+
+// Случайное decimal: мантисса до 10^6 (small) или 96-битная, scale и знак
+static s21_decimal random_decimal(uint64_t *state, int small, int scale,
+                                  int sign) {
+  s21_decimal value = {{0}};
+  uint64_t x = bench_random(state);
+  if (small) {
+    value.bits[0] = (unsigned int)(x % 1000000);
+  } else {
+    value.bits[0] = (unsigned int)x;
+    value.bits[1] = (unsigned int)(x >> 32);
+    value.bits[2] = (unsigned int)bench_random(state);
+  }
+  value.bits[3] = ((unsigned int)scale << 16) | ((unsigned int)sign << 31);
+  return value;
+}
+
+static void fill_dataset(bench_dataset *data, int kind, uint64_t *state) {
+  for (int i = 0; i < BENCH_INPUTS; i++) {
+    int scale_a = (int)(bench_random(state) % 29);
+    int scale_b = (int)(bench_random(state) % 29);
+    int sign_a = (int)(bench_random(state) & 1);
+    int sign_b = (int)(bench_random(state) & 1);
+    int small = (kind == DS_SMALL_EQUAL || kind == DS_SMALL_MIXED);
+    if (kind == DS_SMALL_EQUAL) scale_a = scale_b = 2;
+    if (kind == DS_FULL_EQUAL) scale_b = scale_a;
+    data->a[i] = random_decimal(state, small, scale_a, sign_a);
+    data->b[i] = random_decimal(state, small, scale_b, sign_b);
+
+    if (kind == DS_OVERFLOW) {
+      // Сумма и произведение не помещаются, частное - при делителе < 1
+      data->a[i].bits[2] = 0xFFFFFFFFu - (unsigned int)(i & 0xFF);
+      data->a[i].bits[3] = (unsigned int)sign_a << 31;
+      data->b[i].bits[2] |= 0xF0000000u;
+      data->b[i].bits[3] = ((unsigned int)(i % 2) * 28u << 16) |
+                           ((unsigned int)sign_a << 31);
+    } else if (kind == DS_UNIT) {
+      data->a[i] = random_decimal(state, 1, 5, 0);
+      // Без is_zero: бенчмарк линкуется и с разделяемой библиотекой, где
+      // вспомогательные функции скрыты
+      s21_decimal *value = &data->a[i];
+      if (!(value->bits[0] | value->bits[1] | value->bits[2])) {
+        value->bits[0] = 1;
+      }
+    }
+
+    uint64_t x = bench_random(state);
+    data->numbers[i] = (int64_t)(x % 2000001) - 1000000;
+    if (data->numbers[i] == 0) data->numbers[i] = 7;
+    data->ints[i] = (int)(unsigned int)bench_random(state);
+    s21_from_decimal_to_float(data->a[i], &data->floats[i]);
+  }
+}
+
+// Поток из генератора нагрузки (s21_workload): смесь цен, количеств,
+// курсов, сумм и P&L и трасса операций с такими же пропорциями
+static void fill_workload(bench_dataset *data) {
+  s21_workload workload;
+  s21_workload_init(&workload, 42);
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, data->a, BENCH_INPUTS);
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, data->b, BENCH_INPUTS);
+  s21_workload_trace(&workload, data->trace, BENCH_INPUTS);
+  for (int i = 0; i < BENCH_INPUTS; i++) {
+    s21_decimal quantity = s21_workload_next(&workload, S21_WORKLOAD_QUANTITY);
+    data->numbers[i] = quantity.bits[0];
+    data->ints[i] = (int)quantity.bits[0];
+    s21_from_decimal_to_float(data->a[i], &data->floats[i]);
+  }
+}
+
+static void fill_datasets(void) {
+  static const char *names[DS_COUNT] = {
+      "small_equal", "small_mixed", "full_equal", "full_mixed",
+      "overflow",    "unit",        "workload"};
+  uint64_t state = 0x5EED5EED12345678ULL;
+  for (int i = 0; i < DS_COUNT; i++) {
+    datasets[i].name = names[i];
+    if (1 << i == DS_WORKLOAD) {
+      fill_workload(&datasets[i]);
+    } else {
+      fill_dataset(&datasets[i], 1 << i, &state);
+    }
+  }
+  for (int i = 0; i < BENCH_INPUTS; i++) {
+    compound_rates[i] = (s21_decimal){{1u + (unsigned int)(i % 10), 0, 0,
+                                       2u << 16}};
+    compound_periods[i] = 1 + i % 30;
+  }
+}
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s [--filter NAME] [--samples N] [--warmup MS] "
+          "[--sample-us US] [--cpu N] [--quick]\n"
+          "       [--repeat N] [--json PATH] [--commit ID] [--flags FLAGS]\n"
+          "       %s --matrix [--filter NAME] [--reps N] [--batch N] "
+          "[--csv PATH] [--json PATH] [--cpu N] [--quick]\n"
+          "       %s --compare BASELINE.json CURRENT.json [--threshold PCT]\n"
+          "       %s --atomic [--filter MODE] [--ops N] [--quick]\n"
+          "       %s --parallel [--filter NAME] [--count N] [--quick]\n"
+          "       %s --group [--count N] [--quick]\n",
+          program, program, program, program, program, program);
+}
+
+// Разбор аргументов; возвращает 0 при ошибке
+static int parse_options(int argc, char **argv, bench_options *options) {
+  int ok = 1;
+  for (int i = 1; i < argc && ok; i++) {
+    int has_value = (i + 1 < argc);
+    if (!strcmp(argv[i], "--quick")) {
+      options->samples = 30;
+      options->warmup_ms = 2.0;
+      options->sample_us = 20.0;
+      options->matrix_reps = 3;
+      options->matrix_batch = 4;
+      options->atomic_ops = 10000;
+      options->parallel_count = 200000;
+    } else if (!strcmp(argv[i], "--atomic")) {
+      options->atomic = 1;
+    } else if (!strcmp(argv[i], "--ops") && has_value) {
+      options->atomic_ops = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--parallel")) {
+      options->parallel = 1;
+    } else if (!strcmp(argv[i], "--group")) {
+      options->group = 1;
+    } else if (!strcmp(argv[i], "--count") && has_value) {
+      options->parallel_count = (size_t)strtoull(argv[++i], NULL, 0);
+    } else if (!strcmp(argv[i], "--matrix")) {
+      options->matrix = 1;
+    } else if (!strcmp(argv[i], "--reps") && has_value) {
+      options->matrix_reps = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--batch") && has_value) {
+      options->matrix_batch = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--repeat") && has_value) {
+      options->repeat = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--commit") && has_value) {
+      options->commit = argv[++i];
+    } else if (!strcmp(argv[i], "--flags") && has_value) {
+      options->flags = argv[++i];
+    } else if (!strcmp(argv[i], "--compare") && i + 2 < argc) {
+      options->baseline_path = argv[++i];
+      options->current_path = argv[++i];
+    } else if (!strcmp(argv[i], "--threshold") && has_value) {
+      options->threshold = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--csv") && has_value) {
+      options->csv_path = argv[++i];
+    } else if (!strcmp(argv[i], "--json") && has_value) {
+      options->json_path = argv[++i];
+    } else if (!strcmp(argv[i], "--filter") && has_value) {
+      options->filter = argv[++i];
+    } else if (!strcmp(argv[i], "--samples") && has_value) {
+      options->samples = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--warmup") && has_value) {
+      options->warmup_ms = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--sample-us") && has_value) {
+      options->sample_us = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--cpu") && has_value) {
+      options->cpu = atoi(argv[++i]);
+    } else {
+      ok = 0;
+    }
+  }
+  return ok;
+}
+
+// Обычный прогон: repeat повторов всех случаев, при json_path результаты
+// сохраняются вместе с метаданными
+static int run_benchmarks(const bench_options *options) {
+  bench_report *report = malloc(sizeof(bench_report));
+  if (!report) return 1;
+  bench_report_init(report, options->commit, options->flags);
+  int repeat = (options->repeat > 0) ? options->repeat : 1;
+  if (repeat > BENCH_MAX_RUNS) repeat = BENCH_MAX_RUNS;
+
+  fill_datasets();
+  for (int r = 0; r < repeat; r++) {
+    if (repeat > 1) printf("run %d/%d\n", r + 1, repeat);
+    bench_print_header(stdout);
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      if (options->filter && !strstr(cases[c].name, options->filter)) {
+        continue;
+      }
+      for (int d = 0; d < DS_COUNT; d++) {
+        if (!(cases[c].datasets & (1 << d))) continue;
+        bench_job job = {&cases[c], &datasets[d]};
+        bench_stats stats;
+        bench_measure(run_job, &job, options, &stats);
+        bench_print_row(stdout, cases[c].name, datasets[d].name, &stats);
+        bench_record *record =
+            bench_report_record(report, cases[c].name, datasets[d].name);
+        if (record) record->mean_ns[record->runs++] = stats.mean_ns;
+      }
+    }
+  }
+
+  int status = 0;
+  if (options->json_path && bench_report_write(report, options->json_path)) {
+    fprintf(stderr, "bench: could not write %s\n", options->json_path);
+    status = 1;
+  }
+  free(report);
+  return status;
+}
+
+int main(int argc, char **argv) {
+  bench_options options;
+  bench_default_options(&options);
+  if (!parse_options(argc, argv, &options)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (options.baseline_path) {
+    return bench_compare(options.baseline_path, options.current_path,
+                         options.threshold);
+  }
+  // Потоки не привязываются: иначе все они окажутся на одном ядре
+  if (options.atomic) return bench_atomic_run(&options);
+  if (options.parallel) return bench_parallel_run(&options);
+  if (options.group) return bench_group_run(&options);
+  if (bench_pin_cpu(options.cpu) != 0) {
+    fprintf(stderr, "bench: could not pin to cpu %d\n", options.cpu);
+  }
+
+  return options.matrix ? bench_matrix_run(&options)
+                        : run_benchmarks(&options);
+}
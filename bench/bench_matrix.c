@@ -0,0 +1,200 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define MATRIX_SCALES 29
+#define MATRIX_CELLS (MATRIX_SCALES * MATRIX_SCALES)
+
+// Функции матрицы: арифметика или сравнение
+typedef struct {
+  const char *name;
+  int (*binary)(s21_decimal, s21_decimal, s21_decimal *);
+  int (*compare)(s21_decimal, s21_decimal);
+} matrix_function;
+
+static const matrix_function functions[] = {
+    {"s21_add", s21_add, NULL},
+    {"s21_mul", s21_mul, NULL},
+    {"s21_div", s21_div, NULL},
+    {"s21_is_less", NULL, s21_is_less},
+    {"s21_is_less_or_equal", NULL, s21_is_less_or_equal},
+    {"s21_is_greater", NULL, s21_is_greater},
+    {"s21_is_greater_or_equal", NULL, s21_is_greater_or_equal},
+    {"s21_is_equal", NULL, s21_is_equal},
+    {"s21_is_not_equal", NULL, s21_is_not_equal},
+};
+
+// Неудобные мантиссы: пара (a, b) для каждого класса
+typedef struct {
+  const char *name;
+  unsigned int a[3];
+  unsigned int b[3];
+} matrix_mantissa;
+
+static const matrix_mantissa mantissas[] = {
+    // маленькие числа: выравнивание scale почти бесплатно
+    {"small", {123, 0, 0}, {7, 0, 0}},
+    // произвольные 96-битные мантиссы
+    {"full",
+     {0x9ABCDEF1u, 0x12345678u, 0x0FEDCBA9u},
+     {0x87654321u, 0xDEADBEEFu, 0x01234567u}},
+    // 2^96 - 1: любое выравнивание и умножение переполняют
+    {"max",
+     {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu},
+     {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu}},
+    // 10^28 и 10^28 - 1: граница числа цифр
+    {"pow10",
+     {0x10000000u, 0x3E250261u, 0x204FCE5Eu},
+     {0x0FFFFFFFu, 0x3E250261u, 0x204FCE5Eu}},
+    // 28 девяток и 3: длинная бесконечная дробь при делении
+    {"nines", {0x0FFFFFFFu, 0x3E250261u, 0x204FCE5Eu}, {3, 0, 0}},
+};
+
+#define FUNCTION_COUNT (sizeof(functions) / sizeof(functions[0]))
+#define MANTISSA_COUNT (sizeof(mantissas) / sizeof(mantissas[0]))
+
+// Результат одной ячейки
+typedef struct {
+  double cycles;  // медиана тактов на вызов
+  double ns;      // медиана наносекунд на вызов
+  int code;       // код возврата (для сравнений - результат)
+} matrix_cell;
+
+static s21_decimal make_operand(const unsigned int *mantissa, int scale) {
+  s21_decimal value = {{mantissa[0], mantissa[1], mantissa[2], 0}};
+  value.bits[3] = (unsigned int)scale << 16;
+  return value;
+}
+
+static int compare_double(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Медиана reps замеров по batch вызовов
+static void measure_cell(const matrix_function *function, s21_decimal a,
+                         s21_decimal b, const bench_options *options,
+                         matrix_cell *cell) {
+  int reps = (options->matrix_reps > 0) ? options->matrix_reps : 1;
+  int batch = (options->matrix_batch > 0) ? options->matrix_batch : 1;
+  double cycles[64];
+  double times[64];
+  if (reps > 64) reps = 64;
+
+  s21_decimal result = {{0}};
+  unsigned int acc = 0;
+  for (int r = 0; r < reps; r++) {
+    uint64_t begin_ns = bench_now_ns();
+    uint64_t begin = bench_cycles();
+    for (int i = 0; i < batch; i++) {
+      if (function->binary) {
+        cell->code = function->binary(a, b, &result);
+      } else {
+        cell->code = function->compare(a, b);
+      }
+      acc += result.bits[0];
+    }
+    cycles[r] = (double)(bench_cycles() - begin) / batch;
+    times[r] = (double)(bench_now_ns() - begin_ns) / batch;
+  }
+  bench_sink += acc;
+
+  qsort(cycles, reps, sizeof(double), compare_double);
+  qsort(times, reps, sizeof(double), compare_double);
+  cell->cycles = cycles[reps / 2];
+  cell->ns = times[reps / 2];
+}
+
+// Сводка по матрице: медиана и худшая ячейка
+static void print_summary(const char *function, const char *mantissa,
+                          const matrix_cell *cells) {
+  double sorted[MATRIX_CELLS];
+  int worst = 0;
+  for (int i = 0; i < MATRIX_CELLS; i++) {
+    sorted[i] = cells[i].cycles;
+    if (cells[i].cycles > cells[worst].cycles) worst = i;
+  }
+  qsort(sorted, MATRIX_CELLS, sizeof(double), compare_double);
+  printf("%-26s %-8s %12.0f %12.0f %12.0f   (%d, %d)\n", function, mantissa,
+         sorted[0], sorted[MATRIX_CELLS / 2], sorted[MATRIX_CELLS - 1],
+         worst / MATRIX_SCALES, worst % MATRIX_SCALES);
+}
+
+static void write_csv(FILE *csv, const char *function, const char *mantissa,
+                      const matrix_cell *cells) {
+  for (int i = 0; i < MATRIX_CELLS; i++) {
+    fprintf(csv, "%s,%s,%d,%d,%.1f,%.1f,%d\n", function, mantissa,
+            i / MATRIX_SCALES, i % MATRIX_SCALES, cells[i].cycles,
+            cells[i].ns, cells[i].code);
+  }
+}
+
+// Одна матрица в JSON: строки - scale первого операнда, столбцы - второго
+static void write_json(FILE *json, int first, const char *function,
+                       const char *mantissa, const matrix_cell *cells) {
+  fprintf(json, "%s\n    {\"function\": \"%s\", \"mantissa\": \"%s\",",
+          first ? "" : ",", function, mantissa);
+  fprintf(json, "\n     \"cycles\": [");
+  for (int row = 0; row < MATRIX_SCALES; row++) {
+    fprintf(json, "%s\n      [", row ? "," : "");
+    for (int col = 0; col < MATRIX_SCALES; col++) {
+      fprintf(json, "%s%.1f", col ? ", " : "",
+              cells[row * MATRIX_SCALES + col].cycles);
+    }
+    fprintf(json, "]");
+  }
+  fprintf(json, "]}");
+}
+
+int bench_matrix_run(const bench_options *options) {
+  FILE *csv = options->csv_path ? fopen(options->csv_path, "w") : NULL;
+  FILE *json = options->json_path ? fopen(options->json_path, "w") : NULL;
+  matrix_cell *cells = malloc(sizeof(matrix_cell) * MATRIX_CELLS);
+  int status = 0;
+  if ((options->csv_path && !csv) || (options->json_path && !json) ||
+      !cells) {
+    fprintf(stderr, "bench: could not open matrix output\n");
+    status = 1;
+  }
+
+  if (status == 0) {
+    if (csv) fprintf(csv, "function,mantissa,scale_a,scale_b,cycles,ns,code\n");
+    if (json) {
+      fprintf(json, "{\n  \"unit\": \"cycles_per_call\",\n");
+      fprintf(json, "  \"scales\": %d,\n  \"matrices\": [", MATRIX_SCALES);
+    }
+    printf("%-26s %-8s %12s %12s %12s   %s\n", "function", "mantissa",
+           "min cyc", "median cyc", "max cyc", "worst (scale_a, scale_b)");
+
+    int first = 1;
+    for (size_t f = 0; f < FUNCTION_COUNT; f++) {
+      if (options->filter && !strstr(functions[f].name, options->filter)) {
+        continue;
+      }
+      for (size_t m = 0; m < MANTISSA_COUNT; m++) {
+        for (int i = 0; i < MATRIX_CELLS; i++) {
+          s21_decimal a =
+              make_operand(mantissas[m].a, i / MATRIX_SCALES);
+          s21_decimal b =
+              make_operand(mantissas[m].b, i % MATRIX_SCALES);
+          measure_cell(&functions[f], a, b, options, &cells[i]);
+        }
+        print_summary(functions[f].name, mantissas[m].name, cells);
+        if (csv) write_csv(csv, functions[f].name, mantissas[m].name, cells);
+        if (json) {
+          write_json(json, first, functions[f].name, mantissas[m].name,
+                     cells);
+        }
+        first = 0;
+      }
+    }
+    if (json) fprintf(json, "\n  ]\n}\n");
+  }
+
+  if (csv) fclose(csv);
+  if (json) fclose(json);
+  free(cells);
+  return status;
+}
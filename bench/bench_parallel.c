@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Входные массивы: P&L (scale 2, оба знака), цены, количества и делители;
+// out - выход поэлементных пакетов
+typedef struct {
+  s21_decimal *values;
+  s21_decimal *prices;
+  s21_decimal *quantities;
+  int64_t *numbers;
+  s21_decimal *out;
+  size_t n;
+} parallel_data;
+
+// Один прогон случая по политике policy
+typedef int (*parallel_body)(const parallel_data *data,
+                             const s21_exec_policy *policy,
+                             s21_decimal *result);
+
+// Последовательная цепочка s21_add: точка отсчета для сумм
+static int run_add_chain(const parallel_data *data,
+                         const s21_exec_policy *policy, s21_decimal *result) {
+  (void)policy;
+  s21_decimal sum = {{0}};
+  int status = CodeOK;
+  for (size_t i = 0; i < data->n && status == CodeOK; i++) {
+    status = s21_add(sum, data->values[i], &sum);
+  }
+  *result = sum;
+  return status;
+}
+
+static int run_sum(const parallel_data *data,
+                   const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_reduce_sum_parallel(data->values, data->n, policy, result);
+}
+
+static int run_min(const parallel_data *data,
+                   const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_reduce_min_parallel(data->values, data->n, policy, result);
+}
+
+static int run_max(const parallel_data *data,
+                   const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_reduce_max_parallel(data->values, data->n, policy, result);
+}
+
+static int run_dot(const parallel_data *data,
+                   const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_reduce_dot_parallel(data->prices, data->quantities, data->n,
+                                 policy, result);
+}
+
+// VWAP через s21_mul, s21_add и s21_div: точка отсчета для
+// взвешенного среднего (округляет каждое произведение и сумму)
+static int run_vwap_chain(const parallel_data *data,
+                          const s21_exec_policy *policy, s21_decimal *result) {
+  (void)policy;
+  s21_decimal notional = {{0}};
+  s21_decimal volume = {{0}};
+  int status = CodeOK;
+  for (size_t i = 0; i < data->n && status == CodeOK; i++) {
+    s21_decimal product;
+    status = s21_mul(data->prices[i], data->quantities[i], &product);
+    if (status == CodeOK) status = s21_add(notional, product, &notional);
+    if (status == CodeOK) {
+      status = s21_add(volume, data->quantities[i], &volume);
+    }
+  }
+  if (status == CodeOK) status = s21_div(notional, volume, result);
+  return status;
+}
+
+static int run_weighted(const parallel_data *data,
+                        const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_weighted_avg_n(data->prices, data->quantities, data->n, 6,
+                            result, policy);
+}
+
+// Моменты P&L и цен за один проход, в result - выборочная ковариация
+static int run_moments(const parallel_data *data,
+                       const s21_exec_policy *policy, s21_decimal *result) {
+  s21_moments moments;
+  int status =
+      s21_moments_n(data->values, data->prices, data->n, &moments, policy);
+  if (status == CodeOK) status = s21_moments_covariance(&moments, 1, 6, result);
+  return status;
+}
+
+// Поэлементные пакеты: в result - XOR всех выходов для сверки
+static void fold_out(const parallel_data *data, s21_decimal *result) {
+  s21_decimal fold = {{0}};
+  for (size_t i = 0; i < data->n; i++) {
+    for (int w = 0; w < 4; w++) fold.bits[w] ^= data->out[i].bits[w];
+  }
+  *result = fold;
+}
+
+static int run_add_i64(const parallel_data *data,
+                       const s21_exec_policy *policy, s21_decimal *result) {
+  int status = s21_add_i64_n(data->values, data->numbers, data->out, NULL,
+                             data->n, policy);
+  fold_out(data, result);
+  return status;
+}
+
+static int run_div_i64(const parallel_data *data,
+                       const s21_exec_policy *policy, s21_decimal *result) {
+  int status = s21_div_i64_n(data->prices, data->numbers, data->out, NULL,
+                             data->n, policy);
+  fold_out(data, result);
+  return status;
+}
+
+static int run_prefix(const parallel_data *data,
+                      const s21_exec_policy *policy, s21_decimal *result) {
+  int status = s21_prefix_sum(data->values, data->out, data->n, NULL, policy);
+  fold_out(data, result);
+  return status;
+}
+
+// Окно по последним 1000 сделкам: каждая сделка - push и вытеснение самой
+// старой; VWAP (деление через s21_div) считается один раз в конце
+static int run_window(const parallel_data *data,
+                      const s21_exec_policy *policy, s21_decimal *result) {
+  (void)policy;
+  s21_window window;
+  int status = s21_window_init(&window, 1000);
+  for (size_t i = 0; i < data->n && status == CodeOK; i++) {
+    status = s21_window_push(&window, (int64_t)i, data->prices[i],
+                             data->quantities[i]);
+  }
+  if (status == CodeOK) status = s21_window_vwap(&window, result);
+  s21_window_free(&window);
+  return status;
+}
+
+static int compare_decimals(const void *a, const void *b) {
+  const s21_decimal *x = a;
+  const s21_decimal *y = b;
+  return s21_is_less(*x, *y) ? -1 : s21_is_greater(*x, *y);
+}
+
+// Медиана через копию и qsort с s21_is_less: точка отсчета для выбора
+static int run_sort_nth(const parallel_data *data,
+                        const s21_exec_policy *policy, s21_decimal *result) {
+  (void)policy;
+  memcpy(data->out, data->values, sizeof(s21_decimal) * data->n);
+  qsort(data->out, data->n, sizeof(s21_decimal), compare_decimals);
+  *result = data->out[data->n / 2];
+  return CodeOK;
+}
+
+static int run_nth(const parallel_data *data,
+                   const s21_exec_policy *policy, s21_decimal *result) {
+  return s21_nth_element(data->values, data->n, data->n / 2, result, policy);
+}
+
+// 100 наибольших, в result - сотый
+static int run_top_k(const parallel_data *data,
+                     const s21_exec_policy *policy, s21_decimal *result) {
+  size_t k = data->n < 100 ? data->n : 100;
+  int status = s21_top_k(data->values, data->n, k, data->out, NULL, policy);
+  *result = data->out[k - 1];
+  return status;
+}
+
+typedef struct {
+  const char *name;
+  parallel_body body;
+  int sequential;  // только один поток
+} parallel_case;
+
+static const parallel_case cases[] = {
+    {"s21_add_chain", run_add_chain, 1},
+    {"reduce_sum", run_sum, 0},
+    {"reduce_min", run_min, 0},
+    {"reduce_max", run_max, 0},
+    {"reduce_dot", run_dot, 0},
+    {"vwap_chain", run_vwap_chain, 1},
+    {"weighted_avg_n", run_weighted, 0},
+    {"moments_n", run_moments, 0},
+    {"add_i64_n", run_add_i64, 0},
+    {"div_i64_n", run_div_i64, 0},
+    {"prefix_sum", run_prefix, 0},
+    {"window_push", run_window, 1},
+    {"sort_nth", run_sort_nth, 1},
+    {"nth_element", run_nth, 0},
+    {"top_k", run_top_k, 0},
+};
+
+// Прогон случая на встроенном пуле с 1-16 участниками; same - результат и
+// код совпадают с однопоточным побитно
+static int run_case(const parallel_case *item, const parallel_data *data) {
+  static const int thread_counts[] = {1, 2, 4, 8, 16};
+  s21_decimal first = {{0}};
+  int first_status = 0;
+  double first_ms = 0;
+  int status = 0;
+  size_t counts = item->sequential ? 1 : sizeof(thread_counts) / sizeof(int);
+  for (size_t i = 0; i < counts; i++) {
+    s21_decimal result = {{0}};
+    uint64_t begin = bench_now_ns();
+    s21_exec_policy policy = {S21_EXEC_PARALLEL, thread_counts[i], NULL};
+    int code = item->body(data, &policy, &result);
+    double ms = (double)(bench_now_ns() - begin) / 1e6;
+    if (i == 0) {
+      first = result;
+      first_status = code;
+      first_ms = ms;
+    }
+    int same =
+        (code == first_status) && !memcmp(&result, &first, sizeof(result));
+    printf("%-16s %8d %10.2f %10.2f %8.2f %6s %5d\n", item->name,
+           thread_counts[i], ms, ms * 1e6 / (double)data->n,
+           ms > 0 ? first_ms / ms : 0.0, same ? "yes" : "NO", code);
+    if (!same) status = 1;
+  }
+  return status;
+}
+
+int bench_parallel_run(const bench_options *options) {
+  parallel_data data = {NULL, NULL, NULL, NULL, NULL, 0};
+  data.n = options->parallel_count;
+  if (data.n == 0) data.n = 1;
+  data.values = malloc(sizeof(s21_decimal) * data.n);
+  data.prices = malloc(sizeof(s21_decimal) * data.n);
+  data.quantities = malloc(sizeof(s21_decimal) * data.n);
+  data.numbers = malloc(sizeof(int64_t) * data.n);
+  data.out = malloc(sizeof(s21_decimal) * data.n);
+  int status = 0;
+  if (!data.values || !data.prices || !data.quantities || !data.numbers ||
+      !data.out) {
+    fprintf(stderr, "bench: could not allocate %zu elements\n", data.n);
+    status = 1;
+  } else {
+    s21_workload workload;
+    s21_workload_init(&workload, 42);
+    s21_workload_fill(&workload, S21_WORKLOAD_PNL, data.values, data.n);
+    s21_workload_fill(&workload, S21_WORKLOAD_PRICE, data.prices, data.n);
+    s21_workload_fill(&workload, S21_WORKLOAD_QUANTITY, data.quantities,
+                      data.n);
+    for (size_t i = 0; i < data.n; i++) {
+      data.numbers[i] = 3 + (int64_t)(i % 7);
+    }
+    printf("%zu elements, %d cpus\n", data.n, s21_pool_default_threads());
+    printf("%-16s %8s %10s %10s %8s %6s %5s\n", "case", "threads", "ms",
+           "ns/elem", "speedup", "same", "code");
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      if (!options->filter || strstr(cases[c].name, options->filter)) {
+        status |= run_case(&cases[c], &data);
+      }
+    }
+  }
+  s21_pool_shutdown();
+  free(data.values);
+  free(data.prices);
+  free(data.quantities);
+  free(data.numbers);
+  free(data.out);
+  return status;
+}
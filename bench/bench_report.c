@@ -0,0 +1,276 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+// Копирование строки с обрезкой по размеру буфера
+static void copy_string(char *dst, size_t size, const char *src) {
+  snprintf(dst, size, "%s", (src && *src) ? src : "unknown");
+}
+
+// Модель процессора из /proc/cpuinfo
+static void read_cpu_model(char *dst, size_t size) {
+  char line[512];
+  FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+  copy_string(dst, size, NULL);
+  int found = 0;
+  while (cpuinfo && !found && fgets(line, sizeof(line), cpuinfo)) {
+    char *colon = strchr(line, ':');
+    if (!strncmp(line, "model name", 10) && colon) {
+      colon += (colon[1] == ' ') ? 2 : 1;
+      colon[strcspn(colon, "\n")] = '\0';
+      copy_string(dst, size, colon);
+      found = 1;
+    }
+  }
+  if (cpuinfo) fclose(cpuinfo);
+}
+
+void bench_report_init(bench_report *report, const char *commit,
+                       const char *flags) {
+  memset(report, 0, sizeof(*report));
+  copy_string(report->commit, sizeof(report->commit), commit);
+  copy_string(report->flags, sizeof(report->flags), flags);
+#if defined(__GNUC__) && !defined(__clang__)
+  copy_string(report->compiler, sizeof(report->compiler), "gcc " __VERSION__);
+#elif defined(__VERSION__)
+  copy_string(report->compiler, sizeof(report->compiler), __VERSION__);
+#else
+  copy_string(report->compiler, sizeof(report->compiler), NULL);
+#endif
+  read_cpu_model(report->cpu, sizeof(report->cpu));
+  time_t now = time(NULL);
+  strftime(report->date, sizeof(report->date), "%Y-%m-%dT%H:%M:%SZ",
+           gmtime(&now));
+}
+
+bench_record *bench_report_record(bench_report *report, const char *function,
+                                  const char *dataset) {
+  bench_record *record = NULL;
+  for (int i = 0; i < report->count && !record; i++) {
+    if (!strcmp(report->records[i].function, function) &&
+        !strcmp(report->records[i].dataset, dataset)) {
+      record = &report->records[i];
+    }
+  }
+  if (!record && report->count < BENCH_MAX_RECORDS) {
+    record = &report->records[report->count++];
+    memset(record, 0, sizeof(*record));
+    snprintf(record->function, sizeof(record->function), "%s", function);
+    snprintf(record->dataset, sizeof(record->dataset), "%s", dataset);
+  }
+  return record;
+}
+
+// Строка JSON: кавычки и обратная косая черта экранируются
+static void write_string(FILE *out, const char *value) {
+  fputc('"', out);
+  for (const char *c = value; *c; c++) {
+    if (*c == '"' || *c == '\\') fputc('\\', out);
+    fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+// Запись прогона в JSON. Каждый результат занимает одну строку, это же
+// предполагает bench_report_read
+int bench_report_write(const bench_report *report, const char *path) {
+  FILE *out = fopen(path, "w");
+  if (!out) return 1;
+
+  const char *keys[5] = {"commit", "compiler", "flags", "cpu", "date"};
+  const char *values[5] = {report->commit, report->compiler, report->flags,
+                           report->cpu, report->date};
+  fprintf(out, "{\n");
+  for (int i = 0; i < 5; i++) {
+    fprintf(out, "  \"%s\": ", keys[i]);
+    write_string(out, values[i]);
+    fprintf(out, ",\n");
+  }
+  fprintf(out, "  \"results\": [\n");
+  for (int i = 0; i < report->count; i++) {
+    const bench_record *record = &report->records[i];
+    fprintf(out, "    {\"function\": \"%s\", \"dataset\": \"%s\", ",
+            record->function, record->dataset);
+    fprintf(out, "\"mean_ns\": [");
+    for (int r = 0; r < record->runs; r++) {
+      fprintf(out, "%s%.3f", r ? ", " : "", record->mean_ns[r]);
+    }
+    fprintf(out, "]}%s\n", (i + 1 < report->count) ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+  return fclose(out) != 0;
+}
+
+// Значение строкового поля key из строки line (без разбора экранирования)
+static int read_field(const char *line, const char *key, char *dst,
+                      size_t size) {
+  char pattern[64];
+  snprintf(pattern, sizeof(pattern), "\"%s\": \"", key);
+  const char *start = strstr(line, pattern);
+  int found = 0;
+  if (start) {
+    start += strlen(pattern);
+    size_t length = strcspn(start, "\"");
+    if (length >= size) length = size - 1;
+    memcpy(dst, start, length);
+    dst[length] = '\0';
+    found = 1;
+  }
+  return found;
+}
+
+int bench_report_read(bench_report *report, const char *path) {
+  FILE *in = fopen(path, "r");
+  if (!in) return 1;
+  memset(report, 0, sizeof(*report));
+
+  char line[4096];
+  while (fgets(line, sizeof(line), in)) {
+    char function[sizeof(report->records[0].function)];
+    char dataset[sizeof(report->records[0].dataset)];
+    const char *runs = strstr(line, "\"mean_ns\": [");
+    if (runs && read_field(line, "function", function, sizeof(function)) &&
+        read_field(line, "dataset", dataset, sizeof(dataset))) {
+      bench_record *record = bench_report_record(report, function, dataset);
+      char *cursor = (char *)runs + strlen("\"mean_ns\": [");
+      while (record && record->runs < BENCH_MAX_RUNS && *cursor != ']') {
+        char *end = NULL;
+        double value = strtod(cursor, &end);
+        if (end == cursor) break;
+        record->mean_ns[record->runs++] = value;
+        cursor = end + strspn(end, ", ");
+      }
+    } else {
+      read_field(line, "commit", report->commit, sizeof(report->commit));
+      read_field(line, "compiler", report->compiler,
+                 sizeof(report->compiler));
+      read_field(line, "flags", report->flags, sizeof(report->flags));
+      read_field(line, "cpu", report->cpu, sizeof(report->cpu));
+      read_field(line, "date", report->date, sizeof(report->date));
+    }
+  }
+  fclose(in);
+  return 0;
+}
+
+// Квантиль t-распределения для двустороннего 95% интервала
+static double t_critical(double df) {
+  static const double table[30] = {
+      12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+      2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  int index = (int)df;
+  double value = 1.960;
+  if (index < 1) index = 1;
+  if (index <= 30) value = table[index - 1];
+  return value;
+}
+
+static void mean_variance(const bench_record *record, double *mean,
+                          double *variance) {
+  double sum = 0.0;
+  double squares = 0.0;
+  for (int i = 0; i < record->runs; i++) sum += record->mean_ns[i];
+  *mean = (record->runs > 0) ? sum / record->runs : 0.0;
+  for (int i = 0; i < record->runs; i++) {
+    double d = record->mean_ns[i] - *mean;
+    squares += d * d;
+  }
+  *variance = (record->runs > 1) ? squares / (record->runs - 1) : 0.0;
+}
+
+// Сравнение одного результата. Разница средних оценивается интервалом
+// Уэлча (95%); замедление засчитывается, если оно больше threshold
+// процентов и весь интервал лежит выше нуля. Если повторов меньше двух,
+// интервал не строится: разница выводится с пометкой "no ci", в
+// *untested добавляется 1, а замедлением она не считается
+static int compare_record(const bench_record *base, const bench_record *cur,
+                          double threshold, int *untested) {
+  double base_mean;
+  double base_var;
+  double cur_mean;
+  double cur_var;
+  mean_variance(base, &base_mean, &base_var);
+  mean_variance(cur, &cur_mean, &cur_var);
+
+  double diff = cur_mean - base_mean;
+  double delta = (base_mean > 0) ? 100.0 * diff / base_mean : 0.0;
+  double half = 0.0;
+  int has_interval = (base->runs > 1 && cur->runs > 1);
+  if (has_interval) {
+    double a = base_var / base->runs;
+    double b = cur_var / cur->runs;
+    double df = 1.0;
+    if (a + b > 0) {
+      df = (a + b) * (a + b) /
+           (a * a / (base->runs - 1) + b * b / (cur->runs - 1));
+    }
+    half = t_critical(df) * sqrt(a + b);
+  }
+  double half_pct = (base_mean > 0) ? 100.0 * half / base_mean : 0.0;
+
+  int regression = has_interval && delta > threshold && diff - half > 0;
+  const char *verdict = "~";
+  if (!has_interval) {
+    verdict = "no ci";
+    *untested += 1;
+  } else if (regression) {
+    verdict = "SLOWER";
+  } else if (diff + half < 0 && -delta > threshold) {
+    verdict = "faster";
+  }
+  printf("%-26s %-14s %10.2f %10.2f %+8.2f%% +-%6.2f%%  %s\n", cur->function,
+         cur->dataset, base_mean, cur_mean, delta, half_pct, verdict);
+  return regression;
+}
+
+int bench_compare(const char *baseline_path, const char *current_path,
+                  double threshold) {
+  bench_report *baseline = malloc(sizeof(bench_report));
+  bench_report *current = malloc(sizeof(bench_report));
+  int status = 0;
+  if (!baseline || !current || bench_report_read(baseline, baseline_path) ||
+      bench_report_read(current, current_path)) {
+    fprintf(stderr, "bench: could not read %s or %s\n", baseline_path,
+            current_path);
+    status = 2;
+  }
+
+  if (status == 0) {
+    int regressions = 0;
+    int untested = 0;
+    printf("baseline: %s (%s)\ncurrent:  %s (%s)\n", baseline->commit,
+           baseline->date, current->commit, current->date);
+    if (strcmp(baseline->cpu, current->cpu) != 0) {
+      printf("warning: cpu differs: %s vs %s\n", baseline->cpu, current->cpu);
+    }
+    printf("%-26s %-14s %10s %10s %9s %9s\n", "function", "dataset",
+           "base ns", "cur ns", "delta", "ci95");
+    for (int i = 0; i < current->count; i++) {
+      const bench_record *cur = &current->records[i];
+      const bench_record *base = NULL;
+      for (int j = 0; j < baseline->count && !base; j++) {
+        if (!strcmp(baseline->records[j].function, cur->function) &&
+            !strcmp(baseline->records[j].dataset, cur->dataset)) {
+          base = &baseline->records[j];
+        }
+      }
+      if (base && base->runs > 0 && cur->runs > 0) {
+        regressions += compare_record(base, cur, threshold, &untested);
+      }
+    }
+    printf("%d regression(s) over %.1f%%\n", regressions, threshold);
+    if (untested > 0) {
+      printf("warning: %d result(s) with fewer than 2 runs were not tested "
+             "for significance; rerun with --repeat 2 or more\n",
+             untested);
+    }
+    status = (regressions > 0) ? 1 : 0;
+  }
+  free(baseline);
+  free(current);
+  return status;
+}
@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Текстовое представление decimal (для просмотра сгенерированных потоков)
+static void format_decimal(s21_decimal value, char *buffer) {
+  unsigned int limbs[3] = {value.bits[0], value.bits[1], value.bits[2]};
+  char digits[40];
+  int count = 0;
+  do {
+    digits[count++] = (char)('0' + limbs_div_u32(limbs, 3, 10));
+  } while (limbs[0] || limbs[1] || limbs[2]);
+
+  int scale = get_scale(value);
+  while (count <= scale) digits[count++] = '0';
+  char *out = buffer;
+  if (get_sign(value)) *out++ = '-';
+  for (int i = count - 1; i >= 0; i--) {
+    *out++ = digits[i];
+    if (i == scale && scale > 0) *out++ = '.';
+  }
+  *out = '\0';
+}
+
+static int parse_kind(const char *name, s21_workload_kind *kind) {
+  static const char *names[] = {"price", "quantity", "fx", "notional", "pnl",
+                                "mixed"};
+  int found = 0;
+  for (int i = 0; i < 6 && !found; i++) {
+    if (!strcmp(name, names[i])) {
+      *kind = (s21_workload_kind)i;
+      found = 1;
+    }
+  }
+  return found;
+}
+
+// Счетчики горячих путей за прогон (если библиотека собрана с S21_STATS)
+static void print_stats(void) {
+  s21_stats stats;
+  s21_stats_snapshot(&stats);
+  for (int i = 0; stats.enabled && i < S21_STAT_COUNT; i++) {
+    printf("%-24s %12llu\n", s21_stats_name((s21_stat_counter)i),
+           (unsigned long long)stats.counters[i]);
+  }
+}
+
+// Прогон трассы из файла: количество операций каждого вида, ошибки и
+// среднее время на операцию
+static int replay_file(const char *path) {
+  FILE *in = fopen(path, "r");
+  size_t capacity = 1 << 20;
+  s21_trace_op *ops = malloc(sizeof(s21_trace_op) * capacity);
+  int *codes = malloc(sizeof(int) * capacity);
+  size_t count = 0;
+  int status = 0;
+  if (!in || !ops || !codes ||
+      s21_trace_read(in, ops, capacity, &count) != CodeOK) {
+    fprintf(stderr, "workload: could not read trace %s\n", path);
+    status = 1;
+  }
+
+  if (status == 0) {
+    s21_stats_reset();
+    s21_latency_reset();
+    uint64_t begin = bench_now_ns();
+    s21_trace_replay(ops, count, NULL, codes);
+    uint64_t elapsed = bench_now_ns() - begin;
+
+    size_t per_op[S21_OP_COUNT] = {0};
+    size_t errors[S21_OP_COUNT] = {0};
+    for (size_t i = 0; i < count; i++) {
+      per_op[ops[i].op]++;
+      if (codes[i] != CodeOK) errors[ops[i].op]++;
+    }
+    printf("%-12s %10s %10s\n", "op", "count", "errors");
+    for (int op = 0; op < S21_OP_COUNT; op++) {
+      printf("%-12s %10zu %10zu\n", s21_trace_op_name((s21_trace_op_code)op),
+             per_op[op], errors[op]);
+    }
+    printf("%zu ops, %.2f ns/op\n", count,
+           count ? (double)elapsed / (double)count : 0.0);
+    print_stats();
+    if (*s21_latency_unit()) s21_latency_dump(stdout, S21_LATENCY_TEXT);
+  }
+  if (in) fclose(in);
+  free(ops);
+  free(codes);
+  return status;
+}
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s [--seed N] [--count N] [--kind "
+          "price|quantity|fx|notional|pnl|mixed] [--out PATH]\n"
+          "       %s --trace [--seed N] [--count N] [--out PATH]\n"
+          "       %s --replay PATH [--sample-rate N]\n",
+          program, program, program);
+}
+
+int main(int argc, char **argv) {
+  uint64_t seed = 42;
+  size_t count = 20;
+  s21_workload_kind kind = S21_WORKLOAD_MIXED;
+  int trace = 0;
+  const char *out_path = NULL;
+  const char *replay_path = NULL;
+  int ok = 1;
+  for (int i = 1; i < argc && ok; i++) {
+    int has_value = (i + 1 < argc);
+    if (!strcmp(argv[i], "--seed") && has_value) {
+      seed = strtoull(argv[++i], NULL, 0);
+    } else if (!strcmp(argv[i], "--count") && has_value) {
+      count = (size_t)strtoull(argv[++i], NULL, 0);
+    } else if (!strcmp(argv[i], "--kind") && has_value) {
+      ok = parse_kind(argv[++i], &kind);
+    } else if (!strcmp(argv[i], "--out") && has_value) {
+      out_path = argv[++i];
+    } else if (!strcmp(argv[i], "--sample-rate") && has_value) {
+      // Частота замеров задержек в сборке с S21_LATENCY
+      s21_latency_set_rate((unsigned int)strtoul(argv[++i], NULL, 0));
+    } else if (!strcmp(argv[i], "--replay") && has_value) {
+      replay_path = argv[++i];
+    } else if (!strcmp(argv[i], "--trace")) {
+      trace = 1;
+    } else {
+      ok = 0;
+    }
+  }
+  if (!ok) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (replay_path) return replay_file(replay_path);
+
+  FILE *out = out_path ? fopen(out_path, "w") : stdout;
+  if (!out) {
+    fprintf(stderr, "workload: could not open %s\n", out_path);
+    return 1;
+  }
+  s21_workload workload;
+  s21_workload_init(&workload, seed);
+  int status = 0;
+  if (trace) {
+    fprintf(out, "# s21 trace seed=%llu ops=%zu\n", (unsigned long long)seed,
+            count);
+    for (size_t i = 0; i < count && status == 0; i++) {
+      s21_trace_op op;
+      s21_workload_trace(&workload, &op, 1);
+      status = (s21_trace_write(out, &op, 1) != CodeOK);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      char text[48];
+      s21_decimal value = s21_workload_next(&workload, kind);
+      format_decimal(value, text);
+      fprintf(out, "%08X %08X %08X %08X  %s\n", value.bits[0], value.bits[1],
+              value.bits[2], value.bits[3], text);
+    }
+  }
+  if (out != stdout) fclose(out);
+  return status;
+}
@@ -1,4 +1,4 @@
-#include "s21_decimal.h"
+#include "s21_decimal_inline.h"
 
 // Структуры и вспомогательные функции для BigInt (внутреннее использование)
 
@@ -90,6 +90,7 @@ static int add_same_sign(s21_decimal v1, s21_decimal v2, s21_decimal *res,
   }
 
   if (!fits_in_96(big)) {
+    S21_STAT_INC(S21_STAT_OVERFLOW);
     status = (sign == 0) ? CodeBigNumber : CodeSmallNumber;
   } else {
     for (int i = 0; i < 3; i++) res->bits[i] = big.bits[i];
@@ -132,8 +133,10 @@ static int add_diff_sign(s21_decimal v1, s21_decimal v2, s21_decimal *res) {
 // Нормализация результата умножения (уменьшение scale при переполнении)
 static void mul_normalize(s21_big_decimal *big, int *scale) {
   int stop = 0;
+  S21_STAT_INC(S21_STAT_MUL_NORMALIZE);
   while (*scale > 0 && !stop) {
     if (!fits_in_96(*big) || *scale > 28) {
+      S21_STAT_INC(S21_STAT_MUL_NORMALIZE_STEPS);
       int rem = div_by_10_big(big);
       bank_rounding_big(big, rem);
       (*scale)--;
@@ -169,6 +172,7 @@ static int div_calc_fractional(s21_decimal v2, s21_decimal *rem,
                                s21_decimal *res, int *scale) {
   int status = CodeOK;
   int stop = 0;
+  S21_STAT_INC(S21_STAT_DIV_FRACTIONAL);
   while (!is_zero(*rem) && *scale < 28 && status == CodeOK && !stop) {
     s21_decimal tmp_res = *res;
     s21_decimal tmp_rem = *rem;
@@ -177,6 +181,7 @@ static int div_calc_fractional(s21_decimal v2, s21_decimal *rem,
       s21_decimal part = {0};
       div_calc_integer(*rem, v2, &part, rem);
       if (s21_add(tmp_res, part, res) == CodeOK) {
+        S21_STAT_INC(S21_STAT_DIV_FRACTIONAL_DIGITS);
         (*scale)++;
       } else {
         status = CodeInvalidData;  // Переполнение при сложении дробной части
@@ -188,37 +193,52 @@ static int div_calc_fractional(s21_decimal v2, s21_decimal *rem,
   return status;
 }
 
-// Основные функции
+// Основные функции. Реализация принимает указатели (s21_*_ref), версии
+// по значению - обертки над ней. Входы копируются до записи в result,
+// поэтому result может совпадать с любым из них
 
-int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
+int s21_add_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result) {
+  if (!value_1 || !value_2 || !result) return CodeInvalidData;
+  s21_decimal a = *value_1;
+  s21_decimal b = *value_2;
   *result = decimal_zero();
-  int status = align_scale(&value_1, &value_2);
+  int status = align_scale(&a, &b);
 
   if (status == CodeOK) {
-    if (get_sign(value_1) == get_sign(value_2)) {
-      status = add_same_sign(value_1, value_2, result, get_sign(value_1));
+    if (get_sign(a) == get_sign(b)) {
+      status = add_same_sign(a, b, result, get_sign(a));
     } else {
-      status = add_diff_sign(value_1, value_2, result);
+      status = add_diff_sign(a, b, result);
     }
   }
   return status;
 }
 
+int s21_sub_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result) {
+  if (!value_2) return CodeInvalidData;
+  s21_decimal negated = *value_2;
+  set_sign(&negated, !get_sign(negated));
+  return s21_add_ref(value_1, &negated, result);
+}
+
+int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  S21_TIMED(S21_LAT_ADD);
+  return s21_add_ref(&value_1, &value_2, result);
+}
+
 int s21_sub(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
-  set_sign(&value_2, !get_sign(value_2));
-  return s21_add(value_1, value_2, result);
+  S21_TIMED(S21_LAT_SUB);
+  return s21_sub_ref(&value_1, &value_2, result);
 }
 
-int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
-  *result = decimal_zero();
+// Запись произведения в результат: нормализация scale и проверка
+// переполнения (общая часть s21_mul и s21_mul_i64)
+static int mul_store_result(s21_big_decimal res_big, int scale, int sign,
+                            s21_decimal *result) {
   int status = CodeOK;
-  int sign = get_sign(value_1) ^ get_sign(value_2);
-  int scale = get_scale(value_1) + get_scale(value_2);
-  s21_big_decimal res_big = mul_big(value_1, value_2);
-
+  *result = decimal_zero();
   if (!is_zero_big(res_big)) {
     mul_normalize(&res_big, &scale);
     if (fits_in_96(res_big) && scale <= 28) {
@@ -226,6 +246,7 @@ int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
       set_scale(result, scale);
       set_sign(result, sign);
     } else {
+      S21_STAT_INC(S21_STAT_OVERFLOW);
       status = (sign == 0) ? CodeBigNumber : CodeSmallNumber;
     }
   } else {
@@ -234,43 +255,281 @@ int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
   return status;
 }
 
-int s21_div(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
-  if (is_zero(value_2)) return CodeDivisionZero;
+int s21_mul_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result) {
+  if (!value_1 || !value_2 || !result) return CodeInvalidData;
+  int sign = get_sign(*value_1) ^ get_sign(*value_2);
+  int scale = get_scale(*value_1) + get_scale(*value_2);
+  return mul_store_result(mul_big(*value_1, *value_2), scale, sign, result);
+}
+
+int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  S21_TIMED(S21_LAT_MUL);
+  return s21_mul_ref(&value_1, &value_2, result);
+}
+
+int s21_div_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result) {
+  if (!value_1 || !value_2 || !result) return CodeInvalidData;
+  if (is_zero(*value_2)) return CodeDivisionZero;
+  s21_decimal dividend = *value_1;
+  s21_decimal divisor = *value_2;
   *result = decimal_zero();
 
   int return_code = CodeOK;
 
-  int sign = get_sign(value_1) ^ get_sign(value_2);
-  int scale = get_scale(value_1) - get_scale(value_2);
-  set_scale(&value_1, 0);
-  set_sign(&value_1, 0);
-  set_scale(&value_2, 0);
-  set_sign(&value_2, 0);
+  int sign = get_sign(dividend) ^ get_sign(divisor);
+  int scale = get_scale(dividend) - get_scale(divisor);
+  set_scale(&dividend, 0);
+  set_sign(&dividend, 0);
+  set_scale(&divisor, 0);
+  set_sign(&divisor, 0);
 
   // Выравнивание отрицательного scale
   while (scale < 0) {
-    if (mul_by_10(&value_1) == CodeOK) {
+    if (mul_by_10(&dividend) == CodeOK) {
       scale++;
     } else {
       // Если делимое не влезает, уменьшаем делитель
-      int rem = div_by_10(&value_2);
-      s21_bank_rounding(&value_2, rem);  // Внешняя функция
+      int rem = div_by_10(&divisor);
+      s21_bank_rounding(&divisor, rem);  // Внешняя функция
       scale++;
     }
   }
 
-  if (is_zero(value_2))
+  if (is_zero(divisor))
     return_code = CodeDivisionZero;  // Защита от схлопывания в 0
 
   if (return_code == CodeOK) {
     s21_decimal rem = {0};
-    div_calc_integer(value_1, value_2, result, &rem);
-    div_calc_fractional(value_2, &rem, result, &scale);
+    div_calc_integer(dividend, divisor, result, &rem);
+    div_calc_fractional(divisor, &rem, result, &scale);
 
     set_sign(result, sign);
     set_scale(result, scale);
   }
 
   return return_code;
-}
\ No newline at end of file
+}
+
+int s21_div(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  S21_TIMED(S21_LAT_DIV);
+  return s21_div_ref(&value_1, &value_2, result);
+}
+
+// Операции на месте: acc = acc op value. При ошибке acc не меняется
+
+typedef int (*s21_ref_operation)(const s21_decimal *, const s21_decimal *,
+                                 s21_decimal *);
+
+static int apply_assign(s21_ref_operation operation, s21_decimal *acc,
+                        const s21_decimal *value) {
+  if (!acc) return CodeInvalidData;
+  s21_decimal result;
+  int status = operation(acc, value, &result);
+  if (status == CodeOK) *acc = result;
+  return status;
+}
+
+int s21_add_assign(s21_decimal *acc, const s21_decimal *value) {
+  return apply_assign(s21_add_ref, acc, value);
+}
+
+int s21_sub_assign(s21_decimal *acc, const s21_decimal *value) {
+  return apply_assign(s21_sub_ref, acc, value);
+}
+
+int s21_mul_assign(s21_decimal *acc, const s21_decimal *value) {
+  return apply_assign(s21_mul_ref, acc, value);
+}
+
+int s21_div_assign(s21_decimal *acc, const s21_decimal *value) {
+  return apply_assign(s21_div_ref, acc, value);
+}
+
+// Смешанная арифметика decimal и целых чисел
+
+// Модуль int64_t без переполнения на INT64_MIN
+static unsigned long long abs_i64(int64_t number) {
+  return (number < 0) ? 0ULL - (unsigned long long)number
+                      : (unsigned long long)number;
+}
+
+// Перевод модуля целого числа и знака в decimal со scale 0
+static s21_decimal decimal_from_u64(unsigned long long magnitude, int sign) {
+  s21_decimal result = decimal_zero();
+  result.bits[0] = (unsigned int)magnitude;
+  result.bits[1] = (unsigned int)(magnitude >> 32);
+  set_sign(&result, sign);
+  return result;
+}
+
+// Умножение 96-битной мантиссы на 64-битное число (результат до 160 бит)
+static s21_big_decimal mul_big_u64(s21_decimal value,
+                                   unsigned long long number) {
+  s21_big_decimal res = {0};
+  unsigned int factor[2] = {(unsigned int)number,
+                            (unsigned int)(number >> 32)};
+  for (int j = 0; j < 2; j++) {
+    unsigned long long carry = 0;
+    for (int i = 0; i < 3; i++) {
+      unsigned long long sum = (unsigned long long)value.bits[i] * factor[j] +
+                               res.bits[i + j] + carry;
+      res.bits[i + j] = (unsigned int)sum;
+      carry = sum >> 32;
+    }
+    res.bits[j + 3] = (unsigned int)carry;
+  }
+  return res;
+}
+
+// Мантисса * factor + addend, возвращает 1 при выходе за 96 бит
+static int mul_add_u32(s21_decimal *value, unsigned int factor,
+                       unsigned int addend) {
+  unsigned long long carry = addend;
+  for (int i = 0; i < 3; i++) {
+    unsigned long long cur =
+        (unsigned long long)value->bits[i] * factor + carry;
+    value->bits[i] = (unsigned int)cur;
+    carry = cur >> 32;
+  }
+  return carry != 0;
+}
+
+// Сложение decimal с целым magnitude со знаком sign.
+// Целое приводится к scale значения одним умножением 96x64 на 10^scale
+// вместо пошагового align_scale. Если результат не помещается в мантиссу,
+// используется общий путь s21_add с его округлением
+static int add_integer(s21_decimal value, unsigned long long magnitude,
+                       int sign, s21_decimal *result) {
+  int status = CodeOK;
+  int scale = get_scale(value);
+  s21_big_decimal scaled = mul_big_u64(decimal_pow10(scale), magnitude);
+
+  if (fits_in_96(scaled)) {
+    S21_STAT_INC(S21_STAT_FAST_ADD_I64);
+    s21_decimal number = decimal_zero();
+    for (int i = 0; i < 3; i++) number.bits[i] = scaled.bits[i];
+    set_scale(&number, scale);
+    set_sign(&number, sign);
+    *result = decimal_zero();
+    if (get_sign(value) == sign) {
+      status = add_same_sign(value, number, result, sign);
+    } else {
+      status = add_diff_sign(value, number, result);
+    }
+  } else {
+    status = s21_add(value, decimal_from_u64(magnitude, sign), result);
+  }
+  return status;
+}
+
+int s21_add_i64(s21_decimal value, int64_t number, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  return add_integer(value, abs_i64(number), number < 0, result);
+}
+
+int s21_sub_i64(s21_decimal value, int64_t number, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  // Как в s21_sub: знак вычитаемого инвертируется, в том числе у нуля
+  return add_integer(value, abs_i64(number), number >= 0, result);
+}
+
+int s21_mul_i64(s21_decimal value, int64_t number, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  int sign = get_sign(value) ^ (number < 0);
+  return mul_store_result(mul_big_u64(value, abs_i64(number)),
+                          get_scale(value), sign, result);
+}
+
+int s21_div_i64(s21_decimal value, int64_t number, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  if (number == 0) return CodeDivisionZero;
+
+  int status = CodeOK;
+  unsigned long long divisor = abs_i64(number);
+
+  if (divisor > 0xFFFFFFFFULL) {
+    // Делитель шире одного слова - общий алгоритм деления
+    status = s21_div(value, decimal_from_u64(divisor, number < 0), result);
+  } else {
+    S21_STAT_INC(S21_STAT_FAST_DIV_I64);
+    int sign = get_sign(value) ^ (number < 0);
+    int scale = get_scale(value);
+    *result = value;
+    result->bits[3] = 0;
+    unsigned long long remainder =
+        limbs_div_u32(result->bits, 3, (unsigned int)divisor);
+
+    // Дробная часть по одной цифре, как в div_calc_fractional
+    int stop = 0;
+    while (remainder != 0 && scale < 28 && !stop) {
+      s21_decimal shifted = *result;
+      remainder *= 10;
+      if (!mul_add_u32(&shifted, 10, (unsigned int)(remainder / divisor))) {
+        *result = shifted;
+        remainder %= divisor;
+        scale++;
+      } else {
+        stop = 1;
+      }
+    }
+    set_sign(result, sign);
+    set_scale(result, scale);
+  }
+  return status;
+}
+
+// Пакетные версии
+
+typedef int (*s21_i64_operation)(s21_decimal, int64_t, s21_decimal *);
+
+typedef struct {
+  s21_i64_operation operation;
+  const s21_decimal *values;
+  const int64_t *numbers;
+  s21_decimal *result;
+} i64_batch;
+
+static int i64_element(const void *context, size_t index) {
+  const i64_batch *batch = context;
+  return batch->operation(batch->values[index], batch->numbers[index],
+                          &batch->result[index]);
+}
+
+static int apply_i64_n(s21_i64_operation operation, size_t cost_ns,
+                       const s21_decimal *values, const int64_t *numbers,
+                       s21_decimal *result, int *codes, size_t n,
+                       const s21_exec_policy *policy) {
+  if (n > 0 && (!values || !numbers || !result)) return CodeInvalidData;
+  i64_batch batch = {operation, values, numbers, result};
+  return batch_apply(policy, n, cost_ns, i64_element, &batch, codes);
+}
+
+int s21_add_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy) {
+  return apply_i64_n(s21_add_i64, S21_COST_ADD, values, numbers, result,
+                     codes, n, policy);
+}
+
+int s21_sub_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy) {
+  return apply_i64_n(s21_sub_i64, S21_COST_ADD, values, numbers, result,
+                     codes, n, policy);
+}
+
+int s21_mul_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy) {
+  return apply_i64_n(s21_mul_i64, S21_COST_MUL, values, numbers, result,
+                     codes, n, policy);
+}
+
+int s21_div_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy) {
+  return apply_i64_n(s21_div_i64, S21_COST_DIV, values, numbers, result,
+                     codes, n, policy);
+}
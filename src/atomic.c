@@ -0,0 +1,63 @@
+#include "s21_decimal_inline.h"
+
+void s21_atomic_init(s21_atomic_decimal *target, s21_decimal value) {
+  if (target) target->value = value;
+}
+
+s21_decimal s21_atomic_load(const s21_atomic_decimal *target) {
+  s21_decimal value = {{0}};
+  if (target) __atomic_load(&target->value, &value, __ATOMIC_ACQUIRE);
+  return value;
+}
+
+void s21_atomic_store(s21_atomic_decimal *target, s21_decimal value) {
+  if (target) __atomic_store(&target->value, &value, __ATOMIC_RELEASE);
+}
+
+s21_decimal s21_atomic_exchange(s21_atomic_decimal *target,
+                                s21_decimal value) {
+  s21_decimal previous = {{0}};
+  if (target) {
+    __atomic_exchange(&target->value, &value, &previous, __ATOMIC_ACQ_REL);
+  }
+  return previous;
+}
+
+// Сложение мантисс при равных scale и знаке. Возвращает 0, если сумма не
+// помещается в 96 бит (тогда нужно округление, и считает s21_add)
+static int add_same_scale(const s21_decimal *a, const s21_decimal *b,
+                          s21_decimal *sum) {
+  unsigned long long carry = 0;
+  for (int i = 0; i < 3; i++) {
+    carry += (unsigned long long)a->bits[i] + b->bits[i];
+    sum->bits[i] = (unsigned int)carry;
+    carry >>= 32;
+  }
+  sum->bits[3] = a->bits[3];
+  return carry == 0;
+}
+
+int s21_atomic_add(s21_atomic_decimal *target, s21_decimal value) {
+  if (!target) return CodeInvalidData;
+  int status = CodeOK;
+  int done = 0;
+  s21_decimal current;
+  __atomic_load(&target->value, &current, __ATOMIC_ACQUIRE);
+  while (!done) {
+    s21_decimal next;
+    // Слова bits[3] (scale и знак) совпадают - быстрый путь без выравнивания
+    if (current.bits[3] == value.bits[3] &&
+        add_same_scale(&current, &value, &next)) {
+      S21_STAT_INC(S21_STAT_FAST_ATOMIC_ADD);
+    } else {
+      status = s21_add_ref(&current, &value, &next);
+    }
+    // При ошибке значение не меняется; при неудачном CAS current получает
+    // свежее значение и сумма пересчитывается
+    done = (status != CodeOK) ||
+           __atomic_compare_exchange(&target->value, &current, &next, 1,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    if (!done) S21_STAT_INC(S21_STAT_ATOMIC_RETRIES);
+  }
+  return status;
+}
@@ -1,4 +1,4 @@
-#include "s21_decimal.h"
+#include "s21_decimal_inline.h"
 
 // Оператор сравнения
 static int s21_comparison_operator(s21_decimal value_1, s21_decimal value_2) {
@@ -34,6 +34,7 @@ static int s21_comparison_operator(s21_decimal value_1, s21_decimal value_2) {
 
 // Меньше
 int s21_is_less(s21_decimal value_1, s21_decimal value_2) {
+  S21_TIMED(S21_LAT_IS_LESS);
   int result = 0;
 
   if (!(is_zero(value_1) && is_zero(value_2))) {
@@ -54,6 +55,7 @@ int s21_is_less(s21_decimal value_1, s21_decimal value_2) {
 
 // Меньше или равно
 int s21_is_less_or_equal(s21_decimal value_1, s21_decimal value_2) {
+  S21_TIMED(S21_LAT_IS_LESS_OR_EQUAL);
   int result = 0;
 
   if (!(is_zero(value_1) && is_zero(value_2))) {
@@ -75,6 +77,7 @@ int s21_is_less_or_equal(s21_decimal value_1, s21_decimal value_2) {
 }
 
 int s21_is_greater(s21_decimal value_1, s21_decimal value_2) {
+  S21_TIMED(S21_LAT_IS_GREATER);
   int result = 0;
 
   if (!(is_zero(value_1) && is_zero(value_2))) {
@@ -97,6 +100,7 @@ int s21_is_greater(s21_decimal value_1, s21_decimal value_2) {
 
 // Больше или равно
 int s21_is_greater_or_equal(s21_decimal value_1, s21_decimal value_2) {
+  S21_TIMED(S21_LAT_IS_GREATER_OR_EQUAL);
   int result = 0;
 
   if (!(is_zero(value_1) && is_zero(value_2))) {
@@ -119,6 +123,7 @@ int s21_is_greater_or_equal(s21_decimal value_1, s21_decimal value_2) {
 
 // Равно
 int s21_is_equal(s21_decimal num1, s21_decimal num2) {
+  S21_TIMED(S21_LAT_IS_EQUAL);
   int result = 0;
   int status = align_scale(&num1, &num2);
   if ((status == CodeOK && get_sign(num1) == 1 && get_sign(num2) == 1) ||
@@ -133,5 +138,6 @@ int s21_is_equal(s21_decimal num1, s21_decimal num2) {
 
 // Неравенство
 int s21_is_not_equal(s21_decimal value_1, s21_decimal value_2) {
+  S21_TIMED(S21_LAT_IS_NOT_EQUAL);
   return !s21_is_equal(value_1, value_2);
 }
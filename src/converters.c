@@ -1,9 +1,10 @@
 #include <float.h>
 #include <math.h>
 
-#include "s21_decimal.h"
+#include "s21_decimal_inline.h"
 
 int s21_from_int_to_decimal(int src, s21_decimal *dst) {
+  S21_TIMED(S21_LAT_FROM_INT);
   if (!dst) return CodeInvalidData;
   *dst = decimal_zero();
 
@@ -16,6 +17,7 @@ int s21_from_int_to_decimal(int src, s21_decimal *dst) {
 }
 
 int s21_from_decimal_to_int(s21_decimal src, int *dst) {
+  S21_TIMED(S21_LAT_TO_INT);
   if (!dst) return CodeInvalidData;
 
   int return_code = CodeOK;
@@ -41,6 +43,7 @@ int s21_from_decimal_to_int(s21_decimal src, int *dst) {
 }
 
 int s21_from_float_to_decimal(float src, s21_decimal *dst) {
+  S21_TIMED(S21_LAT_FROM_FLOAT);
   if (!dst) return CodeInvalidData;
   *dst = decimal_zero();
 
@@ -124,6 +127,7 @@ int s21_from_float_to_decimal(float src, s21_decimal *dst) {
 }
 
 int s21_from_decimal_to_float(s21_decimal src, float *dst) {
+  S21_TIMED(S21_LAT_TO_FLOAT);
   if (!dst) return CodeInvalidData;
   double temp = 0.0;
   for (int i = 0; i < 3; i++) {
@@ -0,0 +1,706 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "s21_short_sum.h"
+
+// Начальная емкость таблицы: групп и вдвое больше ячеек
+#define GROUP_MIN_CAPACITY 16
+// Строк в блоке гистограммы и раскладки по разделам
+#define GROUP_BLOCK 65536
+// Параллельный режим включается с этого числа строк
+#define GROUP_PARALLEL_MIN_ROWS (4 * GROUP_BLOCK)
+// Выборка ключей для выбора между таблицами блоков и разделами
+#define GROUP_SAMPLE 16384
+// Объем групп одного раздела, под который подбирается число разделов: с
+// ним таблица раздела помещается в L2
+#define GROUP_PARTITION_BYTES (256 * 1024)
+// Раскладка идет за один проход: больше 2^10 потоков записи упираются в
+// TLB и буферы записи
+#define GROUP_MAX_PARTITION_BITS 10
+// Слагаемых короткой суммы группы до сброса в rest (см. s21_short_sum.h)
+#define GROUP_SHORT_LIMIT (1u << 31)
+
+// Канонический ключ: равные значения в разной записи (1.5 и 1.50, -0 и 0)
+// дают одни и те же слова. 0, если scale ключа недопустим
+static int key_from_decimal(s21_decimal value, s21_decimal *key) {
+  int scale = get_scale(value);
+  int valid = scale <= 28;
+  if (valid) {
+    s21_decimal digits = {{value.bits[0], value.bits[1], value.bits[2], 0}};
+    int done = 0;
+    while (scale > 0 && !done) {
+      s21_decimal quotient = digits;
+      if (limbs_div_u32(quotient.bits, 3, 10) == 0) {
+        digits = quotient;
+        scale--;
+      } else {
+        done = 1;
+      }
+    }
+    *key = digits;
+    key->bits[3] = (unsigned int)scale << 16;
+    if (get_sign(value) && !is_zero(digits)) key->bits[3] |= 1u << 31;
+  }
+  return valid;
+}
+
+static s21_decimal key_from_i64(int64_t number) {
+  uint64_t magnitude = number < 0 ? 0 - (uint64_t)number : (uint64_t)number;
+  s21_decimal key = {{(unsigned int)magnitude,
+                      (unsigned int)(magnitude >> 32), 0,
+                      number < 0 ? 1u << 31 : 0}};
+  return key;
+}
+
+// Перемешивание слов ключа финализатором splitmix64: старшие биты идут на
+// номер раздела, младшие - на ячейку таблицы
+static uint64_t key_hash(s21_decimal key) {
+  uint64_t low = ((uint64_t)key.bits[1] << 32) | key.bits[0];
+  uint64_t high = ((uint64_t)key.bits[3] << 32) | key.bits[2];
+  uint64_t hash = low ^ (high * 0x9e3779b97f4a7c15ULL);
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+static int key_equal(const s21_decimal *a, s21_decimal b) {
+  return a->bits[0] == b.bits[0] && a->bits[1] == b.bits[1] &&
+         a->bits[2] == b.bits[2] && a->bits[3] == b.bits[3];
+}
+
+// Слова, которые при одном scale сравниваются как беззнаковые 128 бит в
+// том же порядке, что и значения: у отрицательных инвертированный модуль
+// без старшего бита, -0 равен 0
+static void ordered_words(s21_decimal value, unsigned int *words) {
+  unsigned int nonzero = (value.bits[0] | value.bits[1] | value.bits[2]) != 0;
+  unsigned int mask = 0u - ((unsigned int)get_sign(value) & nonzero);
+  for (int i = 0; i < 3; i++) words[i] = value.bits[i] ^ mask;
+  words[3] = ~mask & 0x80000000u;
+}
+
+// a < b; при одинаковых scale - вычитанием с заемом без ветвлений (знаки
+// в потоке значений предсказываются плохо), иначе через s21_is_less
+static int group_less(s21_decimal a, s21_decimal b) {
+  int less = 0;
+  if (get_scale(a) == get_scale(b)) {
+    unsigned int x[4];
+    unsigned int y[4];
+    ordered_words(a, x);
+    ordered_words(b, y);
+    unsigned long long borrow = 0;
+    for (int i = 0; i < 4; i++) {
+      borrow = ((unsigned long long)x[i] - y[i] - borrow) >> 63;
+    }
+    less = (int)borrow;
+  } else {
+    less = s21_is_less(a, b);
+  }
+  return less;
+}
+
+static int group_rest(s21_group *group) {
+  if (!group->rest) {
+    group->rest = malloc(sizeof(s21_wide));
+    if (group->rest) *group->rest = wide_zero();
+  }
+  return group->rest ? CodeOK : CodeInvalidData;
+}
+
+// Добавление значения: min и max меняются только на строго меньшее и
+// большее, поэтому из равных остается первое по порядку строк
+static int group_add(s21_group *group, s21_decimal value) {
+  int status = CodeOK;
+  if (group->count == 0) {
+    group->min = value;
+    group->max = value;
+    group->sum_scale = get_scale(value);
+  } else {
+    if (group_less(value, group->min)) group->min = value;
+    if (group_less(group->max, value)) group->max = value;
+  }
+  if (get_scale(value) == group->sum_scale) {
+    short_add(group->sum_bits, value);
+  } else {
+    status = group_rest(group);
+    if (status == CodeOK) status = wide_add_decimal(group->rest, value);
+  }
+  group->count++;
+  if (status == CodeOK && group->count % GROUP_SHORT_LIMIT == 0) {
+    s21_wide sum;
+    short_to_wide(group->sum_bits, group->sum_scale, &sum);
+    status = group_rest(group);
+    if (status == CodeOK) status = wide_add(group->rest, &sum);
+    memset(group->sum_bits, 0, sizeof(group->sum_bits));
+  }
+  return status;
+}
+
+// Хеш-таблица с открытой адресацией. Ячейка - 8 байт: старшие 32 бита хеша
+// и номер группы + 1 (0 - пусто), поэтому проба почти всегда решается по
+// ячейке, не читая группу. Группы лежат подряд в порядке появления
+typedef struct {
+  s21_group *groups;
+  size_t count;
+  size_t capacity;
+  uint64_t *slots;
+  size_t mask;
+} group_builder;
+
+static void builder_init(group_builder *builder) {
+  memset(builder, 0, sizeof(*builder));
+}
+
+static void builder_free(group_builder *builder) {
+  for (size_t i = 0; i < builder->count; i++) free(builder->groups[i].rest);
+  free(builder->groups);
+  free(builder->slots);
+  builder_init(builder);
+}
+
+// Вдвое больше ячеек, ключи раскладываются заново
+static int builder_rehash(group_builder *builder) {
+  size_t size = builder->slots ? 2 * (builder->mask + 1)
+                               : 2 * GROUP_MIN_CAPACITY;
+  uint64_t *slots = calloc(size, sizeof(uint64_t));
+  if (!slots) return CodeInvalidData;
+  for (size_t i = 0; i < builder->count; i++) {
+    uint64_t hash = key_hash(builder->groups[i].key);
+    size_t position = hash & (size - 1);
+    while (slots[position] != 0) position = (position + 1) & (size - 1);
+    slots[position] = (hash >> 32 << 32) | (i + 1);
+  }
+  free(builder->slots);
+  builder->slots = slots;
+  builder->mask = size - 1;
+  return CodeOK;
+}
+
+static int builder_append(group_builder *builder, s21_decimal key,
+                          size_t row) {
+  int status = builder->count < UINT32_MAX ? CodeOK : CodeInvalidData;
+  if (status == CodeOK && builder->count == builder->capacity) {
+    size_t capacity = builder->capacity ? 2 * builder->capacity
+                                        : GROUP_MIN_CAPACITY;
+    s21_group *groups =
+        realloc(builder->groups, sizeof(s21_group) * capacity);
+    if (groups) {
+      builder->groups = groups;
+      builder->capacity = capacity;
+    } else {
+      status = CodeInvalidData;
+    }
+  }
+  if (status == CodeOK) {
+    s21_group *group = &builder->groups[builder->count++];
+    memset(group, 0, sizeof(*group));
+    group->key = key;
+    group->first = row;
+  }
+  return status;
+}
+
+// Номер группы с ключом key; новая группа добавляется в конец
+static int builder_find(group_builder *builder, s21_decimal key,
+                        uint64_t hash, size_t row, size_t *index) {
+  int status = CodeOK;
+  // Заполнение таблицы - не больше половины
+  if (!builder->slots || 2 * (builder->count + 1) > builder->mask + 1) {
+    status = builder_rehash(builder);
+  }
+  uint64_t tag = hash >> 32 << 32;
+  size_t position = hash & builder->mask;
+  int found = status != CodeOK;
+  while (!found) {
+    uint64_t slot = builder->slots[position];
+    if (slot == 0) {
+      *index = builder->count;
+      status = builder_append(builder, key, row);
+      if (status == CodeOK) builder->slots[position] = tag | (*index + 1);
+      found = 1;
+    } else if ((slot & ~0xffffffffULL) == tag &&
+               key_equal(&builder->groups[(uint32_t)slot - 1].key, key)) {
+      *index = (uint32_t)slot - 1;
+      found = 1;
+    } else {
+      position = (position + 1) & builder->mask;
+    }
+  }
+  return status;
+}
+
+static int builder_add(group_builder *builder, s21_decimal key,
+                       uint64_t hash, s21_decimal value, size_t row) {
+  size_t index = 0;
+  int status = builder_find(builder, key, hash, row, &index);
+  if (status == CodeOK) status = group_add(&builder->groups[index], value);
+  return status;
+}
+
+// Слияние с группой того же ключа из более поздних строк: из равных min и
+// max остаются прежние, короткая сумма other уходит в rest
+static int group_merge(s21_group *group, const s21_group *other) {
+  if (group_less(other->min, group->min)) group->min = other->min;
+  if (group_less(group->max, other->max)) group->max = other->max;
+  s21_wide sum;
+  short_to_wide(other->sum_bits, other->sum_scale, &sum);
+  int status = group_rest(group);
+  if (status == CodeOK) status = wide_add(group->rest, &sum);
+  if (status == CodeOK && other->rest) {
+    status = wide_add(group->rest, other->rest);
+  }
+  group->count += other->count;
+  return status;
+}
+
+// Перенос группы other в builder: новая переходит целиком вместе с rest
+static int builder_merge(group_builder *builder, s21_group *other) {
+  size_t index = 0;
+  size_t count = builder->count;
+  int status = builder_find(builder, other->key, key_hash(other->key),
+                            other->first, &index);
+  if (status == CodeOK && builder->count > count) {
+    builder->groups[index] = *other;
+    other->rest = NULL;
+  } else if (status == CodeOK) {
+    status = group_merge(&builder->groups[index], other);
+  }
+  return status;
+}
+
+// Столбцы входа: ключи int64 или decimal (другой указатель - NULL)
+typedef struct {
+  const int64_t *int_keys;
+  const s21_decimal *decimal_keys;
+  const s21_decimal *values;
+  size_t n;
+} group_source;
+
+// Канонический ключ строки i. Ключ возвращается по значению: записанный
+// по частям и прочитанный целиком через память, он стоил бы задержки
+// перенаправления записи на каждой строке. valid = 0, если ключ или
+// значение недопустимы
+static s21_decimal row_key(const group_source *source, size_t i,
+                           int *valid) {
+  s21_decimal key = {{0}};
+  *valid = get_scale(source->values[i]) <= 28;
+  if (source->int_keys) {
+    key = key_from_i64(source->int_keys[i]);
+  } else if (!key_from_decimal(source->decimal_keys[i], &key)) {
+    *valid = 0;
+  }
+  return key;
+}
+
+// Строки [begin, end) в таблицу builder
+static int build_rows(const group_source *source, size_t begin, size_t end,
+                      group_builder *builder, uint64_t *first_error) {
+  int status = CodeOK;
+  for (size_t i = begin; i < end && status == CodeOK; i++) {
+    int valid = 0;
+    s21_decimal key = row_key(source, i, &valid);
+    if (valid) {
+      status = builder_add(builder, key, key_hash(key), source->values[i], i);
+    } else {
+      batch_note_error(first_error, i, CodeInvalidData);
+    }
+  }
+  return status;
+}
+
+// Строка, разложенная в свой раздел: ключ уже канонический
+typedef struct {
+  s21_decimal key;
+  s21_decimal value;
+  size_t row;
+} group_row;
+
+typedef struct {
+  const group_source *source;
+  size_t blocks;
+  int shift;  // номер раздела - старшие 64 - shift битов хеша
+  size_t partitions;
+  size_t *offsets;  // по блокам и разделам: счетчики, затем позиции
+  size_t *starts;   // начало каждого раздела в rows и общий конец
+  group_row *rows;
+  group_builder *builders;  // по блокам или по разделам
+  uint64_t *firsts;         // битовая карта первых строк групп
+  size_t *ranks;            // групп до каждого слова карты
+  s21_group *groups;        // итоговый массив
+  int failed;
+  uint64_t first_error;
+} group_context;
+
+static size_t block_end(const group_context *context, size_t block) {
+  size_t last = (block + 1) * GROUP_BLOCK;
+  return (last < context->source->n) ? last : context->source->n;
+}
+
+static void note_failure(group_context *context, int status) {
+  if (status != CodeOK) {
+    __atomic_store_n(&context->failed, 1, __ATOMIC_RELAXED);
+  }
+}
+
+// Мало ключей: у каждого блока своя небольшая таблица
+static void local_blocks(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    group_builder *builder = &context->builders[block];
+    int status = build_rows(context->source, block * GROUP_BLOCK,
+                            block_end(context, block), builder,
+                            &context->first_error);
+    free(builder->slots);
+    builder->slots = NULL;
+    note_failure(context, status);
+  }
+}
+
+static void histogram_blocks(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t *counts = context->offsets + block * context->partitions;
+    memset(counts, 0, sizeof(size_t) * context->partitions);
+    for (size_t i = block * GROUP_BLOCK; i < block_end(context, block); i++) {
+      int valid = 0;
+      s21_decimal key = row_key(context->source, i, &valid);
+      if (valid) {
+        counts[key_hash(key) >> context->shift]++;
+      } else {
+        batch_note_error(&context->first_error, i, CodeInvalidData);
+      }
+    }
+  }
+}
+
+// Раскладка сохраняет порядок строк внутри раздела
+static void scatter_blocks(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t *positions = context->offsets + block * context->partitions;
+    for (size_t i = block * GROUP_BLOCK; i < block_end(context, block); i++) {
+      int valid = 0;
+      s21_decimal key = row_key(context->source, i, &valid);
+      if (valid) {
+        group_row *row =
+            &context->rows[positions[key_hash(key) >> context->shift]++];
+        row->key = key;
+        row->value = context->source->values[i];
+        row->row = i;
+      }
+    }
+  }
+}
+
+static void build_partitions(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t partition = begin; partition < end; partition++) {
+    group_builder *builder = &context->builders[partition];
+    int status = CodeOK;
+    for (size_t i = context->starts[partition];
+         i < context->starts[partition + 1] && status == CodeOK; i++) {
+      const group_row *row = &context->rows[i];
+      status = builder_add(builder, row->key, key_hash(row->key), row->value,
+                           row->row);
+    }
+    free(builder->slots);
+    builder->slots = NULL;
+    note_failure(context, status);
+  }
+}
+
+// Первые строки групп отмечаются в битовой карте; место группы в итоге -
+// число отмеченных строк до ее первой. Так группы разделов встают в
+// порядок первого появления без слияния
+static void mark_firsts(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t partition = begin; partition < end; partition++) {
+    const group_builder *builder = &context->builders[partition];
+    for (size_t i = 0; i < builder->count; i++) {
+      size_t first = builder->groups[i].first;
+      __atomic_fetch_or(&context->firsts[first / 64], 1ULL << (first % 64),
+                        __ATOMIC_RELAXED);
+    }
+  }
+}
+
+static void place_groups(void *argument, size_t begin, size_t end) {
+  group_context *context = argument;
+  for (size_t partition = begin; partition < end; partition++) {
+    group_builder *builder = &context->builders[partition];
+    for (size_t i = 0; i < builder->count; i++) {
+      size_t first = builder->groups[i].first;
+      uint64_t below = context->firsts[first / 64] &
+                       ((1ULL << (first % 64)) - 1);
+      size_t place =
+          context->ranks[first / 64] + (size_t)__builtin_popcountll(below);
+      context->groups[place] = builder->groups[i];
+    }
+    // Суммы rest перешли в итог
+    builder->count = 0;
+  }
+}
+
+static int partition_bits(size_t n) {
+  int bits = 1;
+  while (bits < GROUP_MAX_PARTITION_BITS &&
+         (n >> bits) * sizeof(s21_group) > GROUP_PARTITION_BYTES) {
+    bits++;
+  }
+  return bits;
+}
+
+// Смещения строк каждого блока в каждом разделе: разделы идут подряд, в
+// разделе - блоки по порядку
+static size_t partition_offsets(group_context *context) {
+  size_t offset = 0;
+  for (size_t p = 0; p < context->partitions; p++) {
+    context->starts[p] = offset;
+    for (size_t block = 0; block < context->blocks; block++) {
+      size_t *count = &context->offsets[block * context->partitions + p];
+      size_t rows = *count;
+      *count = offset;
+      offset += rows;
+    }
+  }
+  context->starts[context->partitions] = offset;
+  return offset;
+}
+
+// Раскладка строк по разделам по старшим битам хеша (гистограмма блоков,
+// смещения, запись) и таблица у каждого раздела
+static int partition_build(group_context *context,
+                           const s21_exec_policy *policy) {
+  int bits = partition_bits(context->source->n);
+  context->shift = 64 - bits;
+  context->partitions = (size_t)1 << bits;
+  context->offsets =
+      malloc(sizeof(size_t) * context->blocks * context->partitions);
+  context->starts = malloc(sizeof(size_t) * (context->partitions + 1));
+  int status = (context->offsets && context->starts) ? CodeOK
+                                                     : CodeInvalidData;
+  if (status == CodeOK) {
+    status =
+        s21_exec_for(policy, context->blocks, 1, histogram_blocks, context);
+  }
+  if (status == CodeOK) {
+    size_t rows = partition_offsets(context);
+    context->rows = malloc(sizeof(group_row) * (rows ? rows : 1));
+    if (!context->rows) status = CodeInvalidData;
+  }
+  if (status == CodeOK) {
+    status = s21_exec_for(policy, context->blocks, 1, scatter_blocks, context);
+  }
+  if (status == CodeOK) {
+    status = s21_exec_for(policy, context->partitions, 1, build_partitions,
+                          context);
+  }
+  free(context->rows);
+  free(context->offsets);
+  free(context->starts);
+  return status;
+}
+
+// Группы разделов - в итоговый массив table в порядке первых строк
+static int partition_place(group_context *context,
+                           const s21_exec_policy *policy,
+                           s21_group_table *table) {
+  size_t words = (context->source->n + 63) / 64;
+  size_t total = 0;
+  for (size_t p = 0; p < context->partitions; p++) {
+    total += context->builders[p].count;
+  }
+  context->firsts = calloc(words, sizeof(uint64_t));
+  context->ranks = malloc(sizeof(size_t) * words);
+  context->groups = malloc(sizeof(s21_group) * (total ? total : 1));
+  int status = (context->firsts && context->ranks && context->groups)
+                   ? CodeOK
+                   : CodeInvalidData;
+  if (status == CodeOK) {
+    status =
+        s21_exec_for(policy, context->partitions, 1, mark_firsts, context);
+  }
+  if (status == CodeOK) {
+    size_t rank = 0;
+    for (size_t w = 0; w < words; w++) {
+      context->ranks[w] = rank;
+      rank += (size_t)__builtin_popcountll(context->firsts[w]);
+    }
+    status =
+        s21_exec_for(policy, context->partitions, 1, place_groups, context);
+  }
+  if (status == CodeOK) {
+    table->groups = context->groups;
+    table->count = total;
+  } else {
+    free(context->groups);
+  }
+  free(context->firsts);
+  free(context->ranks);
+  return status;
+}
+
+// Таблицы блоков сливаются по порядку блоков, поэтому новые группы
+// добавляются в порядке первого появления
+static int local_merge(group_context *context, s21_group_table *table) {
+  group_builder result;
+  builder_init(&result);
+  int status = CodeOK;
+  for (size_t block = 0; block < context->blocks && status == CodeOK;
+       block++) {
+    group_builder *builder = &context->builders[block];
+    for (size_t i = 0; i < builder->count && status == CodeOK; i++) {
+      status = builder_merge(&result, &builder->groups[i]);
+    }
+  }
+  if (status == CodeOK) {
+    table->groups = result.groups;
+    table->count = result.count;
+    free(result.slots);
+  } else {
+    builder_free(&result);
+  }
+  return status;
+}
+
+// Оценка по выборке из GROUP_SAMPLE строк: группы выборки помещаются в
+// бюджет раздела, то есть таблица блока и без разбиения остается в L2
+static int sample_few_keys(const group_source *source) {
+  group_builder sample;
+  builder_init(&sample);
+  size_t step = source->n / GROUP_SAMPLE;
+  int status = CodeOK;
+  for (size_t j = 0; j < GROUP_SAMPLE && status == CodeOK; j++) {
+    int valid = 0;
+    size_t index = 0;
+    s21_decimal key = row_key(source, j * step, &valid);
+    if (valid) status = builder_find(&sample, key, key_hash(key), j, &index);
+  }
+  int few = status == CodeOK &&
+            sample.count * sizeof(s21_group) <= GROUP_PARTITION_BYTES;
+  builder_free(&sample);
+  return few;
+}
+
+// Параллельный режим. При немногих ключах (по выборке) таблицы блоков и
+// так в кэше, и каждый блок считается своей таблицей с последующим
+// слиянием. Иначе строки раскладываются по разделам, чтобы таблица
+// раздела помещалась в L2
+static int group_parallel(const group_source *source,
+                          const s21_exec_policy *policy,
+                          s21_group_table *table) {
+  group_context context;
+  memset(&context, 0, sizeof(context));
+  context.source = source;
+  context.blocks = (source->n + GROUP_BLOCK - 1) / GROUP_BLOCK;
+  context.first_error = BATCH_NO_ERROR;
+  int few = sample_few_keys(source);
+  size_t builders = few ? context.blocks
+                        : ((size_t)1 << partition_bits(source->n));
+  context.builders = malloc(sizeof(group_builder) * builders);
+  int status = context.builders ? CodeOK : CodeInvalidData;
+  for (size_t i = 0; status == CodeOK && i < builders; i++) {
+    builder_init(&context.builders[i]);
+  }
+  if (status == CodeOK && few) {
+    status = s21_exec_for(policy, context.blocks, 1, local_blocks, &context);
+  } else if (status == CodeOK) {
+    status = partition_build(&context, policy);
+  }
+  if (status == CodeOK && context.failed) status = CodeInvalidData;
+  if (status == CodeOK) {
+    status = few ? local_merge(&context, table)
+                 : partition_place(&context, policy, table);
+  }
+  for (size_t i = 0; context.builders && i < builders; i++) {
+    builder_free(&context.builders[i]);
+  }
+  free(context.builders);
+  return (status == CodeOK) ? batch_error_code(context.first_error) : status;
+}
+
+static int group_sequential(const group_source *source,
+                            s21_group_table *table) {
+  group_builder builder;
+  builder_init(&builder);
+  uint64_t first_error = BATCH_NO_ERROR;
+  int status = build_rows(source, 0, source->n, &builder, &first_error);
+  if (status == CodeOK) {
+    table->groups = builder.groups;
+    table->count = builder.count;
+    free(builder.slots);
+  } else {
+    builder_free(&builder);
+  }
+  return (status == CodeOK) ? batch_error_code(first_error) : status;
+}
+
+static int group_by(const group_source *source, s21_group_table *table,
+                    const s21_exec_policy *policy) {
+  if (!table || (source->n > 0 && (!source->values ||
+                                   (!source->int_keys &&
+                                    !source->decimal_keys)))) {
+    return CodeInvalidData;
+  }
+  table->groups = NULL;
+  table->count = 0;
+  int parallel = policy && policy->mode != S21_EXEC_SEQUENTIAL &&
+                 source->n >= GROUP_PARALLEL_MIN_ROWS;
+  return parallel ? group_parallel(source, policy, table)
+                  : group_sequential(source, table);
+}
+
+int s21_group_by_i64(const int64_t *keys, const s21_decimal *values,
+                     size_t n, s21_group_table *table,
+                     const s21_exec_policy *policy) {
+  group_source source = {keys, NULL, values, n};
+  return group_by(&source, table, policy);
+}
+
+int s21_group_by_decimal(const s21_decimal *keys, const s21_decimal *values,
+                         size_t n, s21_group_table *table,
+                         const s21_exec_policy *policy) {
+  group_source source = {NULL, keys, values, n};
+  return group_by(&source, table, policy);
+}
+
+void s21_group_table_free(s21_group_table *table) {
+  if (table) {
+    for (size_t i = 0; table->groups && i < table->count; i++) {
+      free(table->groups[i].rest);
+    }
+    free(table->groups);
+    table->groups = NULL;
+    table->count = 0;
+  }
+}
+
+static int group_total(const s21_group *group, s21_wide *total) {
+  short_to_wide(group->sum_bits, group->sum_scale, total);
+  return group->rest ? wide_add(total, group->rest) : CodeOK;
+}
+
+int s21_group_sum(const s21_group *group, s21_decimal *result) {
+  if (!group || !result) return CodeInvalidData;
+  s21_wide total;
+  int status = group_total(group, &total);
+  if (status == CodeOK) {
+    status = wide_to_decimal(&total, S21_ROUND_HALF_EVEN, result);
+  }
+  return status;
+}
+
+int s21_group_avg(const s21_group *group, int scale, s21_decimal *result) {
+  if (!group || !result || scale < 0 || scale > 28) return CodeInvalidData;
+  if (group->count == 0) return CodeDivisionZero;
+  unsigned long long count = group->count;
+  s21_wide total;
+  s21_wide divisor = wide_zero();
+  divisor.bits[0] = (unsigned int)count;
+  divisor.bits[1] = (unsigned int)(count >> 32);
+  int status = group_total(group, &total);
+  if (status == CodeOK) {
+    status = wide_div_to_decimal(&total, &divisor, scale, S21_ROUND_HALF_EVEN,
+                                 result);
+  }
+  return status;
+}
@@ -0,0 +1,289 @@
+#include <string.h>
+
+#include "s21_decimal.h"
+
+#define SUB_COUNT (1 << S21_LATENCY_SUB_BITS)
+
+const char *s21_latency_op_name(s21_latency_op op) {
+  static const char *names[S21_LAT_COUNT] = {
+      "s21_add",
+      "s21_sub",
+      "s21_mul",
+      "s21_div",
+      "s21_is_less",
+      "s21_is_less_or_equal",
+      "s21_is_greater",
+      "s21_is_greater_or_equal",
+      "s21_is_equal",
+      "s21_is_not_equal",
+      "s21_from_int_to_decimal",
+      "s21_from_float_to_decimal",
+      "s21_from_decimal_to_int",
+      "s21_from_decimal_to_float",
+      "s21_floor",
+      "s21_round",
+      "s21_truncate",
+      "s21_negate",
+      "s21_ceil",
+  };
+  const char *name = "unknown";
+  if ((int)op >= 0 && op < S21_LAT_COUNT) name = names[op];
+  return name;
+}
+
+// Наибольшее значение, попадающее в корзину index
+static uint64_t bucket_upper(int index) {
+  uint64_t upper = (uint64_t)index;
+  if (index >= SUB_COUNT) {
+    int shift = index / SUB_COUNT - 1;
+    uint64_t lower = (uint64_t)(SUB_COUNT + index % SUB_COUNT) << shift;
+    upper = lower + ((uint64_t)1 << shift) - 1;
+  }
+  return upper;
+}
+
+uint64_t s21_latency_percentile(const s21_latency_histogram *histogram,
+                                double p) {
+  uint64_t value = 0;
+  if (histogram && histogram->total > 0) {
+    if (p < 0) p = 0;
+    if (p > 100) p = 100;
+    // Ранг замера, ниже или на уровне которого лежит p процентов замеров
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)histogram->total + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    int index = 0;
+    while (index < S21_LATENCY_BUCKETS - 1 &&
+           seen + histogram->counts[index] < rank) {
+      seen += histogram->counts[index];
+      index++;
+    }
+    value = bucket_upper(index);
+    if (value > histogram->max) value = histogram->max;
+    if (value < histogram->min) value = histogram->min;
+  }
+  return value;
+}
+
+// Строка сводки по одной операции
+static void dump_histogram(FILE *out, s21_latency_format format, int first,
+                           s21_latency_op op,
+                           const s21_latency_histogram *histogram) {
+  static const double points[5] = {50.0, 90.0, 99.0, 99.9, 99.99};
+  double mean = (double)histogram->sum / (double)histogram->total;
+  if (format == S21_LATENCY_JSON) {
+    fprintf(out,
+            "%s\n  {\"function\": \"%s\", \"samples\": %llu, "
+            "\"mean\": %.1f, \"min\": %llu, \"max\": %llu, "
+            "\"percentiles\": {",
+            first ? "" : ",", s21_latency_op_name(op),
+            (unsigned long long)histogram->total, mean,
+            (unsigned long long)histogram->min,
+            (unsigned long long)histogram->max);
+    for (int i = 0; i < 5; i++) {
+      fprintf(out, "%s\"%g\": %llu", i ? ", " : "", points[i],
+              (unsigned long long)s21_latency_percentile(histogram,
+                                                         points[i]));
+    }
+    fprintf(out, "}}");
+  } else {
+    fprintf(out, "%-26s %10llu %10.1f", s21_latency_op_name(op),
+            (unsigned long long)histogram->total, mean);
+    for (int i = 0; i < 5; i++) {
+      fprintf(out, " %8llu",
+              (unsigned long long)s21_latency_percentile(histogram,
+                                                         points[i]));
+    }
+    fprintf(out, " %10llu\n", (unsigned long long)histogram->max);
+  }
+}
+
+int s21_latency_dump(FILE *out, s21_latency_format format) {
+  if (!out) return CodeInvalidData;
+  s21_latency_histogram histogram;
+  int first = 1;
+  if (format == S21_LATENCY_JSON) {
+    fprintf(out, "{\"unit\": \"%s\", \"operations\": [", s21_latency_unit());
+  } else {
+    fprintf(out, "%-26s %10s %10s %8s %8s %8s %8s %8s %10s\n", "function",
+            "samples", "mean", "p50", "p90", "p99", "p99.9", "p99.99", "max");
+  }
+  for (int op = 0; op < S21_LAT_COUNT; op++) {
+    s21_latency_merge((s21_latency_op)op, &histogram);
+    if (histogram.total > 0) {
+      dump_histogram(out, format, first, (s21_latency_op)op, &histogram);
+      first = 0;
+    }
+  }
+  if (format == S21_LATENCY_JSON) fprintf(out, "\n]}\n");
+  return ferror(out) ? CodeInvalidData : CodeOK;
+}
+
+#ifdef S21_LATENCY
+
+#include <stdlib.h>
+#include <time.h>
+
+// Гистограммы одного потока. Пишет в них только поток-владелец. Сброс
+// увеличивает глобальную эпоху; поток, заметив новую эпоху, сам обнуляет
+// свои гистограммы, а при слиянии слоты старой эпохи пропускаются
+typedef struct latency_slot {
+  s21_latency_histogram histograms[S21_LAT_COUNT];
+  unsigned int epoch;
+  struct latency_slot *next;
+} latency_slot;
+
+static latency_slot *slots = NULL;
+static unsigned int epoch = 0;
+static unsigned int sample_rate = S21_LATENCY_RATE;
+static _Thread_local latency_slot *own_slot = NULL;
+static _Thread_local unsigned int countdown = 0;
+
+static uint64_t read_timer(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+const char *s21_latency_unit(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return "cycles";
+#else
+  return "ns";
+#endif
+}
+
+void s21_latency_set_rate(unsigned int rate) {
+  __atomic_store_n(&sample_rate, rate, __ATOMIC_RELAXED);
+}
+
+void s21_latency_reset(void) {
+  __atomic_add_fetch(&epoch, 1, __ATOMIC_RELEASE);
+}
+
+// Слот потока создается при первом замере и добавляется в голову списка
+// через CAS. Слоты не освобождаются: замеры завершившихся потоков остаются
+static latency_slot *thread_slot(void) {
+  if (!own_slot) {
+    latency_slot *slot = calloc(1, sizeof(latency_slot));
+    if (slot) {
+      slot->epoch = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+      slot->next = __atomic_load_n(&slots, __ATOMIC_RELAXED);
+      while (!__atomic_compare_exchange_n(&slots, &slot->next, slot, 1,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED)) {
+      }
+      own_slot = slot;
+    }
+  }
+  return own_slot;
+}
+
+static int bucket_index(uint64_t value) {
+  int index = (int)value;
+  if (value >= SUB_COUNT) {
+    int top = 63 - __builtin_clzll(value);
+    int shift = top - S21_LATENCY_SUB_BITS;
+    int sub = (int)((value >> shift) & (SUB_COUNT - 1));
+    index = (shift + 1) * SUB_COUNT + sub;
+    if (index >= S21_LATENCY_BUCKETS) index = S21_LATENCY_BUCKETS - 1;
+  }
+  return index;
+}
+
+static void store(uint64_t *cell, uint64_t value) {
+  __atomic_store_n(cell, value, __ATOMIC_RELAXED);
+}
+
+static uint64_t load(const uint64_t *cell) {
+  return __atomic_load_n(cell, __ATOMIC_RELAXED);
+}
+
+static void record(latency_slot *slot, s21_latency_op op, uint64_t value) {
+  unsigned int current = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+  if (slot->epoch != current) {
+    for (int i = 0; i < S21_LAT_COUNT; i++) {
+      s21_latency_histogram *histogram = &slot->histograms[i];
+      for (int b = 0; b < S21_LATENCY_BUCKETS; b++) {
+        store(&histogram->counts[b], 0);
+      }
+      store(&histogram->total, 0);
+      store(&histogram->sum, 0);
+      store(&histogram->min, 0);
+      store(&histogram->max, 0);
+    }
+    __atomic_store_n(&slot->epoch, current, __ATOMIC_RELEASE);
+  }
+  s21_latency_histogram *histogram = &slot->histograms[op];
+  uint64_t *count = &histogram->counts[bucket_index(value)];
+  uint64_t total = load(&histogram->total);
+  store(count, load(count) + 1);
+  store(&histogram->sum, load(&histogram->sum) + value);
+  if (total == 0 || value < load(&histogram->min)) {
+    store(&histogram->min, value);
+  }
+  if (value > load(&histogram->max)) store(&histogram->max, value);
+  store(&histogram->total, total + 1);
+}
+
+s21_latency_probe s21_latency_begin(s21_latency_op op) {
+  s21_latency_probe probe = {op, 0};
+  unsigned int rate = __atomic_load_n(&sample_rate, __ATOMIC_RELAXED);
+  if (rate > 0) {
+    if (countdown == 0 || countdown > rate) countdown = rate;
+    if (--countdown == 0) probe.start = read_timer();
+  }
+  return probe;
+}
+
+void s21_latency_end(s21_latency_probe *probe) {
+  if (probe->start != 0) {
+    uint64_t stop = read_timer();
+    latency_slot *slot = thread_slot();
+    if (slot) record(slot, probe->op, stop - probe->start);
+  }
+}
+
+int s21_latency_merge(s21_latency_op op, s21_latency_histogram *out) {
+  if (!out || (int)op < 0 || op >= S21_LAT_COUNT) return CodeInvalidData;
+  memset(out, 0, sizeof(*out));
+  unsigned int current = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+  for (latency_slot *slot = __atomic_load_n(&slots, __ATOMIC_ACQUIRE); slot;
+       slot = slot->next) {
+    const s21_latency_histogram *histogram = &slot->histograms[op];
+    if (__atomic_load_n(&slot->epoch, __ATOMIC_ACQUIRE) == current &&
+        load(&histogram->total) > 0) {
+      uint64_t min = load(&histogram->min);
+      uint64_t max = load(&histogram->max);
+      if (out->total == 0 || min < out->min) out->min = min;
+      if (max > out->max) out->max = max;
+      out->sum += load(&histogram->sum);
+      for (int b = 0; b < S21_LATENCY_BUCKETS; b++) {
+        uint64_t count = load(&histogram->counts[b]);
+        out->counts[b] += count;
+        out->total += count;
+      }
+    }
+  }
+  return CodeOK;
+}
+
+#else
+
+const char *s21_latency_unit(void) { return ""; }
+
+void s21_latency_set_rate(unsigned int rate) { (void)rate; }
+
+void s21_latency_reset(void) {}
+
+int s21_latency_merge(s21_latency_op op, s21_latency_histogram *out) {
+  if (!out || (int)op < 0 || op >= S21_LAT_COUNT) return CodeInvalidData;
+  memset(out, 0, sizeof(*out));
+  return CodeOK;
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include "s21_decimal_inline.h"
+
+static void wide_from_count(size_t count, s21_wide *result) {
+  unsigned long long value = count;
+  *result = wide_zero();
+  result->bits[0] = (unsigned int)value;
+  result->bits[1] = (unsigned int)(value >> 32);
+}
+
+void s21_moments_init(s21_moments *moments) {
+  if (moments) {
+    moments->count = 0;
+    moments->sum_x = wide_zero();
+    moments->sum_y = wide_zero();
+    moments->sum_xx = wide_zero();
+    moments->sum_xy = wide_zero();
+  }
+}
+
+int s21_moments_add(s21_moments *moments, s21_decimal x, s21_decimal y) {
+  if (!moments || get_scale(x) > 28 || get_scale(y) > 28) {
+    return CodeInvalidData;
+  }
+  s21_wide wide_x;
+  s21_wide wide_y;
+  s21_wide product;
+  wide_from_decimal(x, &wide_x);
+  wide_from_decimal(y, &wide_y);
+  int status = wide_add(&moments->sum_x, &wide_x);
+  if (status == CodeOK) status = wide_add(&moments->sum_y, &wide_y);
+  if (status == CodeOK) status = wide_mul(&wide_x, &wide_x, &product);
+  if (status == CodeOK) status = wide_add(&moments->sum_xx, &product);
+  if (status == CodeOK) status = wide_mul(&wide_x, &wide_y, &product);
+  if (status == CodeOK) status = wide_add(&moments->sum_xy, &product);
+  if (status == CodeOK) moments->count++;
+  return status;
+}
+
+int s21_moments_merge(s21_moments *moments, const s21_moments *other) {
+  if (!moments || !other) return CodeInvalidData;
+  int status = wide_add(&moments->sum_x, &other->sum_x);
+  if (status == CodeOK) status = wide_add(&moments->sum_y, &other->sum_y);
+  if (status == CodeOK) status = wide_add(&moments->sum_xx, &other->sum_xx);
+  if (status == CodeOK) status = wide_add(&moments->sum_xy, &other->sum_xy);
+  if (status == CodeOK) moments->count += other->count;
+  return status;
+}
+
+static int check_scale(const s21_moments *moments, int scale,
+                       const s21_decimal *result) {
+  return (moments && result && scale >= 0 && scale <= 28) ? CodeOK
+                                                          : CodeInvalidData;
+}
+
+// Числитель и знаменатель центрального момента
+// (n * sum_ab - sum_a * sum_b) / (n * (n - sample)), оба точные
+static int central_terms(const s21_moments *moments, const s21_wide *sum_a,
+                         const s21_wide *sum_b, const s21_wide *sum_ab,
+                         int sample, s21_wide *numerator,
+                         s21_wide *divisor) {
+  if (sample < 0 || moments->count <= (size_t)sample) return CodeDivisionZero;
+  s21_wide count;
+  s21_wide degrees;
+  s21_wide product;
+  wide_from_count(moments->count, &count);
+  wide_from_count(moments->count - (size_t)sample, &degrees);
+  int status = wide_mul(&count, sum_ab, numerator);
+  if (status == CodeOK) status = wide_mul(sum_a, sum_b, &product);
+  if (status == CodeOK) status = wide_sub(numerator, &product);
+  if (status == CodeOK) status = wide_mul(&count, &degrees, divisor);
+  return status;
+}
+
+// Центральный момент одним делением и одним округлением
+static int central_moment(const s21_moments *moments, const s21_wide *sum_a,
+                          const s21_wide *sum_b, const s21_wide *sum_ab,
+                          int sample, int scale, s21_decimal *result) {
+  s21_wide numerator;
+  s21_wide divisor;
+  int status = central_terms(moments, sum_a, sum_b, sum_ab, sample,
+                             &numerator, &divisor);
+  if (status == CodeOK) {
+    status = wide_div_to_decimal(&numerator, &divisor, scale,
+                                 S21_ROUND_HALF_EVEN, result);
+  }
+  return status;
+}
+
+// sqrt(numerator / divisor) с одним округлением до scale. Целая часть
+// numerator / divisor * 10^work (work четный, не меньше 2 * scale + 2 и
+// такой, что частное не меньше 10^4 для wide_isqrt) дает корень с лишней
+// цифрой после scale; признак неточности деления или корня дописывается
+// младшей цифрой, как в s21_sqrt
+static int sqrt_ratio(const s21_wide *numerator, const s21_wide *divisor,
+                      int scale, s21_decimal *result) {
+  int status = CodeOK;
+  if (wide_is_zero(numerator)) {
+    *result = decimal_zero();
+    set_scale(result, scale);
+  } else {
+    // numerator / divisor > 10^order
+    int order = wide_digit_count(numerator) - 1 - numerator->scale -
+                (wide_digit_count(divisor) - divisor->scale);
+    int work = 2 * scale + 2;
+    if (work < 4 - order) work = 4 - order;
+    work += work % 2;
+    s21_wide square;
+    s21_wide root;
+    s21_wide check;
+    status =
+        wide_div(numerator, divisor, work, S21_ROUND_TRUNCATE, &square);
+    if (status == CodeOK) status = wide_mul(&square, divisor, &check);
+    if (status == CodeOK) status = wide_sub(&check, numerator);
+    if (status == CodeOK) {
+      int sticky = !wide_is_zero(&check);
+      square.scale = 0;
+      wide_isqrt(&square, &root);
+      wide_mul(&root, &root, &check);
+      wide_sub(&check, &square);
+      sticky |= !wide_is_zero(&check);
+      limbs_mul_pow10(root.bits, S21_WIDE_LIMBS, 1);
+      root.bits[0] += (unsigned int)sticky;
+      root.scale = work / 2 + 1;
+      status =
+          wide_to_decimal_scale(&root, scale, S21_ROUND_HALF_EVEN, result);
+    }
+  }
+  return status;
+}
+
+int s21_moments_mean(const s21_moments *moments, int scale,
+                     s21_decimal *result) {
+  int status = check_scale(moments, scale, result);
+  if (status == CodeOK && moments->count == 0) status = CodeDivisionZero;
+  if (status == CodeOK) {
+    s21_wide count;
+    wide_from_count(moments->count, &count);
+    status = wide_div_to_decimal(&moments->sum_x, &count, scale,
+                                 S21_ROUND_HALF_EVEN, result);
+  }
+  return status;
+}
+
+int s21_moments_variance(const s21_moments *moments, int sample, int scale,
+                         s21_decimal *result) {
+  int status = check_scale(moments, scale, result);
+  if (status == CodeOK) {
+    status = central_moment(moments, &moments->sum_x, &moments->sum_x,
+                            &moments->sum_xx, sample, scale, result);
+  }
+  return status;
+}
+
+int s21_moments_stddev(const s21_moments *moments, int sample, int scale,
+                       s21_decimal *result) {
+  int status = check_scale(moments, scale, result);
+  s21_wide numerator;
+  s21_wide divisor;
+  if (status == CodeOK) {
+    status = central_terms(moments, &moments->sum_x, &moments->sum_x,
+                           &moments->sum_xx, sample, &numerator, &divisor);
+  }
+  if (status == CodeOK) {
+    status = sqrt_ratio(&numerator, &divisor, scale, result);
+  }
+  return status;
+}
+
+int s21_moments_covariance(const s21_moments *moments, int sample, int scale,
+                           s21_decimal *result) {
+  int status = check_scale(moments, scale, result);
+  if (status == CodeOK) {
+    status = central_moment(moments, &moments->sum_x, &moments->sum_y,
+                            &moments->sum_xy, sample, scale, result);
+  }
+  return status;
+}
@@ -1,31 +1,206 @@
-#include "s21_decimal.h"
+#include "s21_decimal_inline.h"
+
+// Параметры приведения одного входного scale к целевому. Считаются один раз
+// на группу элементов с одинаковым scale
+typedef struct {
+  int power;                   // входной scale - целевой (< 0 - увеличение)
+  unsigned long long divisor;  // 10^power при 0 < power <= 19
+  unsigned long long half;     // divisor / 2
+} quantize_plan;
+
+static quantize_plan make_quantize_plan(int scale, int target_scale) {
+  quantize_plan plan = {scale - target_scale, 0, 0};
+  if (plan.power > 0 && plan.power <= 19) {
+    s21_decimal divisor = decimal_pow10(plan.power);
+    plan.divisor =
+        ((unsigned long long)divisor.bits[1] << 32) | divisor.bits[0];
+    plan.half = plan.divisor / 2;
+  }
+  return plan;
+}
 
-// Получение целой части
-int s21_truncate(s21_decimal value, s21_decimal *result) {
+// Приведение одного значения по готовому плану.
+// При уменьшении масштаба мантисса делится на 10^k один раз: одним 64-битным
+// делением, если мантисса помещается в 64 бита, по словам при k <= 9, иначе
+// проходами по 10^9 с guard-цифрой и sticky-признаком
+static int quantize_one(const quantize_plan *plan, s21_decimal value,
+                        int target_scale, s21_rounding_mode mode,
+                        s21_decimal *result) {
   int status = CodeOK;
+  int sign = get_sign(value);
+  s21_decimal temp_value = value;
+  temp_value.bits[3] = 0;
+
+  if (plan->power > 0) {
+    unsigned long long rem = 0;
+    int half_cmp = 0;
+    int inexact = 0;
+    if (temp_value.bits[2] == 0 && plan->divisor != 0) {
+      S21_STAT_INC(S21_STAT_FAST_QUANTIZE_64);
+      unsigned long long mantissa =
+          ((unsigned long long)temp_value.bits[1] << 32) | temp_value.bits[0];
+      rem = mantissa % plan->divisor;
+      mantissa /= plan->divisor;
+      temp_value.bits[0] = (unsigned int)mantissa;
+      temp_value.bits[1] = (unsigned int)(mantissa >> 32);
+      half_cmp = (rem > plan->half) - (rem < plan->half);
+      inexact = (rem != 0);
+    } else if (plan->power <= 9) {
+      rem = limbs_div_u32(temp_value.bits, 3, (unsigned int)plan->divisor);
+      half_cmp = (rem > plan->half) - (rem < plan->half);
+      inexact = (rem != 0);
+    } else {
+      int sticky = 0;
+      int guard = limbs_div_pow10(temp_value.bits, 3, plan->power, &sticky);
+      half_cmp = (guard > 5 || (guard == 5 && sticky)) - (guard < 5);
+      inexact = (guard != 0 || sticky);
+    }
+    if (rounding_increment_by_half(half_cmp, inexact, temp_value.bits[0] & 1,
+                                   sign, mode)) {
+      // После деления хотя бы на 10 прибавление единицы не переполняет
+      limbs_increment(temp_value.bits, 3);
+    }
+  } else if (plan->power < 0) {
+    if (limbs_mul_pow10(temp_value.bits, 3, -plan->power) != CodeOK) {
+      S21_STAT_INC(S21_STAT_OVERFLOW);
+      status = sign ? CodeSmallNumber : CodeBigNumber;
+    }
+  }
 
-  if (result == NULL) {
-    status = CodeInvalidData;
+  if (status == CodeOK) {
+    *result = temp_value;
+    set_scale(result, target_scale);
+    set_sign(result, sign);
   } else {
     *result = decimal_zero();
-    if (is_zero(value)) {
-      status = CodeOK;
-    } else {
-      int scale = get_scale(value);
-      s21_decimal temp_value = value;
-      while (scale > 0) {
-        div_by_10(&temp_value);
-        scale--;
+  }
+  return status;
+}
+
+// Приведение без проверки входного scale: округления до целого, как и
+// раньше, дают для scale больше 28 результат деления мантиссы (обычно 0)
+static int rescale_any(s21_decimal value, int target_scale,
+                       s21_rounding_mode mode, s21_decimal *result) {
+  quantize_plan plan = make_quantize_plan(get_scale(value), target_scale);
+  return quantize_one(&plan, value, target_scale, mode, result);
+}
+
+// Приведение к масштабу target_scale с округлением в режиме mode. Значение
+// с недопустимым scale отклоняется, как в s21_quantize_n
+int s21_rescale(s21_decimal value, int target_scale, s21_rounding_mode mode,
+                s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  if (target_scale < 0 || target_scale > 28) return CodeInvalidData;
+  if (get_scale(value) > 28) {
+    *result = decimal_zero();
+    return CodeInvalidData;
+  }
+  return rescale_any(value, target_scale, mode, result);
+}
+
+// Размер блока, внутри которого элементы группируются по входному scale
+#define QUANTIZE_BLOCK 256
+// Группа для элементов с недопустимым scale
+#define QUANTIZE_INVALID 29
+
+typedef struct {
+  const s21_decimal *in;
+  s21_decimal *out;
+  int scale;
+  s21_rounding_mode mode;
+  int *codes;
+  uint64_t first_error;
+} quantize_batch;
+
+// Приведение элементов [begin, end). Элементы обрабатываются блоками:
+// внутри блока индексы раскладываются по входному scale (сортировка
+// подсчетом), и каждая группа проходит с одним заранее посчитанным делителем
+static void quantize_range(void *argument, size_t begin, size_t end) {
+  quantize_batch *batch = argument;
+  quantize_plan plans[QUANTIZE_INVALID];
+  int plan_ready[QUANTIZE_INVALID] = {0};
+  unsigned short order[QUANTIZE_BLOCK];
+
+  for (size_t base = begin; base < end; base += QUANTIZE_BLOCK) {
+    size_t len = (end - base < QUANTIZE_BLOCK) ? end - base : QUANTIZE_BLOCK;
+    int start[QUANTIZE_INVALID + 3] = {0};
+
+    for (size_t i = 0; i < len; i++) {
+      int group = get_scale(batch->in[base + i]);
+      if (group > 28) group = QUANTIZE_INVALID;
+      start[group + 2]++;
+    }
+    for (int group = 2; group <= QUANTIZE_INVALID + 2; group++) {
+      start[group] += start[group - 1];
+    }
+    for (size_t i = 0; i < len; i++) {
+      int group = get_scale(batch->in[base + i]);
+      if (group > 28) group = QUANTIZE_INVALID;
+      order[start[group + 1]++] = (unsigned short)i;
+    }
+
+    // После раскладки группа g занимает order[start[g]..start[g + 1])
+    for (int group = 0; group <= QUANTIZE_INVALID; group++) {
+      if (start[group] != start[group + 1] && group != QUANTIZE_INVALID &&
+          !plan_ready[group]) {
+        plans[group] = make_quantize_plan(group, batch->scale);
+        plan_ready[group] = 1;
+      }
+      for (int k = start[group]; k < start[group + 1]; k++) {
+        size_t index = base + order[k];
+        int code = CodeInvalidData;
+        if (group != QUANTIZE_INVALID) {
+          code = quantize_one(&plans[group], batch->in[index], batch->scale,
+                              batch->mode, &batch->out[index]);
+        } else {
+          batch->out[index] = decimal_zero();
+        }
+        if (batch->codes) batch->codes[index] = code;
+        // Группы идут не по порядку индексов, минимум ищет batch_note_error
+        if (code != CodeOK) batch_note_error(&batch->first_error, index, code);
       }
-      *result = temp_value;
-      set_scale(result, 0);
     }
   }
+}
+
+// Пакетное приведение к масштабу scale. Блоки пула кратны QUANTIZE_BLOCK
+int s21_quantize_n(const s21_decimal *in, s21_decimal *out, size_t n,
+                   int scale, s21_rounding_mode mode, int *codes,
+                   const s21_exec_policy *policy) {
+  if (scale < 0 || scale > 28) return CodeInvalidData;
+  if (n > 0 && (!in || !out)) return CodeInvalidData;
+
+  quantize_batch batch = {in, out, scale, mode, codes, BATCH_NO_ERROR};
+  size_t grain = s21_exec_grain(S21_COST_QUANTIZE);
+  grain = (grain + QUANTIZE_BLOCK - 1) / QUANTIZE_BLOCK * QUANTIZE_BLOCK;
+  int status = s21_exec_for(policy, n, grain, quantize_range, &batch);
+  return (status == CodeOK) ? batch_error_code(batch.first_error) : status;
+}
+
+// Округление до целого в режиме mode (ноль всегда дает +0)
+static int round_to_integer(s21_decimal value, s21_rounding_mode mode,
+                            s21_decimal *result) {
+  int status = CodeOK;
+
+  if (result == NULL) {
+    status = CodeInvalidData;
+  } else if (is_zero(value)) {
+    *result = decimal_zero();
+  } else {
+    status = rescale_any(value, 0, mode, result);
+  }
   return status;
 }
 
+// Получение целой части
+int s21_truncate(s21_decimal value, s21_decimal *result) {
+  S21_TIMED(S21_LAT_TRUNCATE);
+  return round_to_integer(value, S21_ROUND_TRUNCATE, result);
+}
+
 // Умножение на -1
 int s21_negate(s21_decimal value, s21_decimal *result) {
+  S21_TIMED(S21_LAT_NEGATE);
   int status = CodeOK;
 
   if (result == NULL) {
@@ -39,66 +214,20 @@ int s21_negate(s21_decimal value, s21_decimal *result) {
   return status;
 }
 
-// Математическое округление
+// Математическое округление (0.5 - от нуля)
 int s21_round(s21_decimal value, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
-  int status = CodeOK;
-  int sign = get_sign(value);
-  int scale = get_scale(value);
-  s21_decimal fractional = value;
-
-  // Извлекаем целую часть
-  status = s21_truncate(value, result);
-
-  // Чтобы узнать первую цифру после запятой:
-  // Уменьшаем масштаб до 1, затем берем остаток от деления на 10
-  set_sign(&fractional, 0);
-  for (int i = 0; i < scale - 1; i++) {
-    div_by_10(&fractional);
-  }
-
-  if (status == CodeOK && scale > 0) {
-    int last_digit = div_by_10(&fractional);
-    if (last_digit >= 5) {
-      s21_decimal one = {{1, 0, 0, 0}};
-      s21_decimal tmp_res = *result;
-      set_sign(&one, sign);
-      status = s21_add(tmp_res, one, result);
-    }
-  }
-
-  if (status == CodeOK) {
-    set_scale(result, 0);
-  }
-
-  return status;
+  S21_TIMED(S21_LAT_ROUND);
+  return round_to_integer(value, S21_ROUND_HALF_UP, result);
 }
 
 // Округление до минус бесконечности
 int s21_floor(s21_decimal value, s21_decimal *result) {
-  if (!result) return CodeInvalidData;
-  int status = CodeOK;
-  int sign = get_sign(value);
-
-  // Получаем целую часть
-  status = s21_truncate(value, result);
-
-  if (status == CodeOK && sign) {
-    s21_decimal diff = {{0}};
-    s21_sub(value, *result, &diff);
-
-    // Если число отрицательное и есть остаток — вычитаем 1
-    if (!is_zero(diff)) {
-      s21_decimal one = {{1, 0, 0, 0}};
-      s21_decimal tmp_res = *result;
-      set_sign(&one, 1);
-      status = s21_add(tmp_res, one, result);
-    }
-  }
-
-  if (status == CodeOK) {
-    set_scale(result, 0);
-  }
+  S21_TIMED(S21_LAT_FLOOR);
+  return round_to_integer(value, S21_ROUND_FLOOR, result);
+}
 
-  return status;
+// Округление до плюс бесконечности
+int s21_ceil(s21_decimal value, s21_decimal *result) {
+  S21_TIMED(S21_LAT_CEIL);
+  return round_to_integer(value, S21_ROUND_CEILING, result);
 }
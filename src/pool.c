@@ -0,0 +1,354 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "s21_decimal.h"
+
+// Очередь участника - непрерывный диапазон номеров блоков [begin, end) в
+// одном слове: begin и end по 24 бита и 16 бит версии. Владелец берет блоки
+// с начала, вор CAS-ом отрезает вторую половину. Версия меняется при каждой
+// записи и защищает CAS вора от ABA, если диапазон вернулся в очередь
+#define RANGE_BITS 24
+#define RANGE_MAX ((1u << RANGE_BITS) - 1)
+
+typedef struct {
+  _Alignas(S21_CACHE_LINE) uint64_t range;
+} range_deque;
+
+typedef struct {
+  s21_pool *pool;
+  int id;  // номер участника (0 - вызывающий поток)
+} pool_worker;
+
+struct s21_pool {
+  pthread_mutex_t run_lock;  // одна работа на пул за раз
+  pthread_mutex_t lock;
+  pthread_cond_t wake;  // новая работа или остановка
+  pthread_cond_t done;  // рабочий закончил свою часть
+  int capacity;         // наибольшее число участников
+  int started;          // запущено рабочих потоков
+  int stop;
+  unsigned long generation;
+  pthread_t *threads;
+  pool_worker *workers;
+  unsigned long *seen;  // последнее поколение, замеченное рабочим
+  range_deque *deques;
+  // Текущая работа (меняется под lock, пока рабочие ждут)
+  s21_range_task task;
+  void *context;
+  size_t n;
+  size_t grain;
+  int participants;
+  int finished;
+};
+
+static pthread_mutex_t builtin_lock = PTHREAD_MUTEX_INITIALIZER;
+static s21_pool *builtin = NULL;
+// Поток пула не запускает вложенную работу, а выполняет ее сам
+static _Thread_local int inside_pool = 0;
+
+static uint64_t pack_range(uint64_t begin, uint64_t end, uint64_t version) {
+  return begin | (end << RANGE_BITS) | (version << (2 * RANGE_BITS));
+}
+
+static uint32_t range_begin(uint64_t range) {
+  return (uint32_t)(range & RANGE_MAX);
+}
+
+static uint32_t range_end(uint64_t range) {
+  return (uint32_t)((range >> RANGE_BITS) & RANGE_MAX);
+}
+
+static uint64_t range_version(uint64_t range) {
+  return (range >> (2 * RANGE_BITS)) + 1;
+}
+
+// Запись в собственную пустую очередь: пустой диапазон никто не меняет
+static void deque_store(range_deque *deque, uint32_t begin, uint32_t end) {
+  uint64_t range = __atomic_load_n(&deque->range, __ATOMIC_RELAXED);
+  __atomic_store_n(&deque->range, pack_range(begin, end, range_version(range)),
+                   __ATOMIC_RELEASE);
+}
+
+static int deque_pop(range_deque *deque, uint32_t *chunk) {
+  uint64_t range = __atomic_load_n(&deque->range, __ATOMIC_ACQUIRE);
+  int found = 0;
+  while (!found && range_begin(range) < range_end(range)) {
+    uint64_t next = pack_range(range_begin(range) + 1, range_end(range),
+                               range_version(range));
+    found = __atomic_compare_exchange_n(&deque->range, &range, next, 1,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    if (found) *chunk = range_begin(range);
+  }
+  return found;
+}
+
+// Забирает вторую половину чужой очереди (последний блок - целиком)
+static int deque_steal(range_deque *deque, uint32_t *begin, uint32_t *end) {
+  uint64_t range = __atomic_load_n(&deque->range, __ATOMIC_ACQUIRE);
+  int found = 0;
+  while (!found && range_begin(range) < range_end(range)) {
+    uint32_t middle =
+        range_begin(range) + (range_end(range) - range_begin(range)) / 2;
+    uint64_t next =
+        pack_range(range_begin(range), middle, range_version(range));
+    found = __atomic_compare_exchange_n(&deque->range, &range, next, 1,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    if (found) {
+      *begin = middle;
+      *end = range_end(range);
+    }
+  }
+  return found;
+}
+
+static void run_chunk(const s21_pool *pool, uint32_t chunk) {
+  size_t begin = (size_t)chunk * pool->grain;
+  size_t end = begin + pool->grain;
+  if (end > pool->n) end = pool->n;
+  pool->task(pool->context, begin, end);
+}
+
+// Часть работы одного участника: свои блоки, затем кража у соседей по
+// кругу, пока у всех не станет пусто
+static void participate(s21_pool *pool, int id) {
+  range_deque *own = &pool->deques[id];
+  int working = 1;
+  while (working) {
+    uint32_t chunk = 0;
+    while (deque_pop(own, &chunk)) run_chunk(pool, chunk);
+    working = 0;
+    for (int k = 1; k < pool->participants && !working; k++) {
+      uint32_t begin = 0;
+      uint32_t end = 0;
+      working = deque_steal(&pool->deques[(id + k) % pool->participants],
+                            &begin, &end);
+      if (working) deque_store(own, begin, end);
+    }
+  }
+}
+
+static void *worker_main(void *argument) {
+  pool_worker *worker = argument;
+  s21_pool *pool = worker->pool;
+  int id = worker->id;
+  inside_pool = 1;
+  pthread_mutex_lock(&pool->lock);
+  while (!pool->stop) {
+    if (pool->seen[id] != pool->generation && id < pool->participants) {
+      pool->seen[id] = pool->generation;
+      pthread_mutex_unlock(&pool->lock);
+      participate(pool, id);
+      pthread_mutex_lock(&pool->lock);
+      if (++pool->finished == pool->participants - 1) {
+        pthread_cond_signal(&pool->done);
+      }
+    } else {
+      pool->seen[id] = pool->generation;
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+int s21_pool_default_threads(void) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus < 1) cpus = 1;
+  if (cpus > S21_POOL_MAX_THREADS) cpus = S21_POOL_MAX_THREADS;
+  return (int)cpus;
+}
+
+s21_pool *s21_pool_create(int threads) {
+  if (threads <= 0) threads = s21_pool_default_threads();
+  if (threads > S21_POOL_MAX_THREADS) threads = S21_POOL_MAX_THREADS;
+  s21_pool *pool = calloc(1, sizeof(s21_pool));
+  if (pool) {
+    pool->capacity = threads;
+    pool->threads = calloc((size_t)threads, sizeof(pthread_t));
+    pool->workers = calloc((size_t)threads, sizeof(pool_worker));
+    pool->seen = calloc((size_t)threads, sizeof(unsigned long));
+    pool->deques = aligned_alloc(S21_CACHE_LINE,
+                                 sizeof(range_deque) * (size_t)threads);
+    if (!pool->threads || !pool->workers || !pool->seen || !pool->deques) {
+      free(pool->threads);
+      free(pool->workers);
+      free(pool->seen);
+      free(pool->deques);
+      free(pool);
+      pool = NULL;
+    }
+  }
+  if (pool) {
+    for (int i = 0; i < threads; i++) pool->deques[i].range = 0;
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+  }
+  return pool;
+}
+
+void s21_pool_destroy(s21_pool *pool) {
+  if (pool) {
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    // Рабочие потоки - участники 1..started
+    for (int i = 1; i <= pool->started; i++) {
+      pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_unlock(&pool->run_lock);
+    pthread_mutex_destroy(&pool->run_lock);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->seen);
+    free(pool->deques);
+    free(pool);
+  }
+}
+
+static s21_pool *builtin_pool(void) {
+  pthread_mutex_lock(&builtin_lock);
+  if (!builtin) builtin = s21_pool_create(S21_POOL_MAX_THREADS);
+  s21_pool *pool = builtin;
+  pthread_mutex_unlock(&builtin_lock);
+  return pool;
+}
+
+void s21_pool_shutdown(void) {
+  pthread_mutex_lock(&builtin_lock);
+  s21_pool_destroy(builtin);
+  builtin = NULL;
+  pthread_mutex_unlock(&builtin_lock);
+}
+
+// Раздача chunks блоков participants участникам поровну и ожидание
+static void pool_run(s21_pool *pool, int participants, size_t chunks,
+                     size_t n, size_t grain, s21_range_task task,
+                     void *context) {
+  pthread_mutex_lock(&pool->run_lock);
+  pthread_mutex_lock(&pool->lock);
+  // Новые рабочие стартуют с текущим поколением и не примут уже
+  // завершенную работу за новую
+  int failed = 0;
+  while (pool->started < participants - 1 && !failed) {
+    int id = pool->started + 1;
+    pool->seen[id] = pool->generation;
+    pool->workers[id] = (pool_worker){pool, id};
+    failed = pthread_create(&pool->threads[id], NULL, worker_main,
+                            &pool->workers[id]);
+    if (!failed) pool->started++;
+  }
+  if (participants > pool->started + 1) participants = pool->started + 1;
+  for (int i = 0; i < participants; i++) {
+    deque_store(&pool->deques[i], (uint32_t)(chunks * i / participants),
+                (uint32_t)(chunks * (i + 1) / participants));
+  }
+  pool->task = task;
+  pool->context = context;
+  pool->n = n;
+  pool->grain = grain;
+  pool->participants = participants;
+  pool->finished = 0;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  inside_pool = 1;
+  participate(pool, 0);
+  inside_pool = 0;
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->finished < pool->participants - 1) {
+    pthread_cond_wait(&pool->done, &pool->lock);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  pthread_mutex_unlock(&pool->run_lock);
+}
+
+int s21_exec_for(const s21_exec_policy *policy, size_t n, size_t grain,
+                 s21_range_task task, void *context) {
+  if (!task) return CodeInvalidData;
+  s21_exec_mode mode = policy ? policy->mode : S21_EXEC_SEQUENTIAL;
+  if (mode == S21_EXEC_POOL && !policy->pool) return CodeInvalidData;
+
+  if (grain == 0) grain = 1;
+  size_t chunks = (n + grain - 1) / grain;
+  while (chunks > RANGE_MAX) {
+    grain *= 2;
+    chunks = (n + grain - 1) / grain;
+  }
+  s21_pool *pool = NULL;
+  int participants = 1;
+  if (mode == S21_EXEC_POOL && chunks > 1 && !inside_pool) {
+    pool = policy->pool;
+    participants = pool->capacity;
+  } else if (mode == S21_EXEC_PARALLEL && chunks > 1 && !inside_pool) {
+    pool = builtin_pool();
+    participants = s21_pool_default_threads();
+  }
+  if (pool && policy->threads > 0) participants = policy->threads;
+  if (pool && participants > pool->capacity) participants = pool->capacity;
+  if ((size_t)participants > chunks) participants = (int)chunks;
+
+  if (pool && participants > 1) {
+    pool_run(pool, participants, chunks, n, grain, task, context);
+  } else if (n > 0) {
+    task(context, 0, n);
+  }
+  return CodeOK;
+}
+
+size_t s21_exec_grain(size_t cost_ns) {
+  size_t grain = S21_EXEC_CHUNK_NS / (cost_ns ? cost_ns : 1);
+  return grain ? grain : 1;
+}
+
+void batch_note_error(uint64_t *first, size_t index, int code) {
+  uint64_t packed = ((uint64_t)index << 3) | (uint64_t)(code + 1);
+  uint64_t current = __atomic_load_n(first, __ATOMIC_RELAXED);
+  while (packed < current &&
+         !__atomic_compare_exchange_n(first, &current, packed, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+int batch_error_code(uint64_t first) {
+  return (first == BATCH_NO_ERROR) ? CodeOK : (int)(first & 7) - 1;
+}
+
+typedef struct {
+  batch_element element;
+  const void *context;
+  int *codes;
+  uint64_t first_error;
+} batch_job;
+
+static void batch_range(void *argument, size_t begin, size_t end) {
+  batch_job *job = argument;
+  int failed = 0;
+  for (size_t i = begin; i < end; i++) {
+    int code = job->element(job->context, i);
+    if (job->codes) job->codes[i] = code;
+    if (code != CodeOK && !failed) {
+      batch_note_error(&job->first_error, i, code);
+      failed = 1;
+    }
+  }
+}
+
+int batch_apply(const s21_exec_policy *policy, size_t n, size_t cost_ns,
+                batch_element element, const void *context, int *codes) {
+  batch_job job = {element, context, codes, BATCH_NO_ERROR};
+  int status = s21_exec_for(policy, n, s21_exec_grain(cost_ns), batch_range,
+                            &job);
+  return (status == CodeOK) ? batch_error_code(job.first_error) : status;
+}
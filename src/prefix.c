@@ -0,0 +1,155 @@
+#include <stdlib.h>
+
+#include "s21_short_sum.h"
+
+// Элементов в блоке скана. Разбиение зависит только от n
+#define SCAN_BLOCK 16384
+
+typedef struct {
+  const s21_decimal *in;
+  s21_decimal *out;
+  int *codes;
+  size_t n;
+  s21_wide *partials;  // суммы блоков, после первого прохода - смещения
+  uint64_t first_error;
+} scan_context;
+
+// Короткая сумма (s21_short_sum.h) и ее scale. 128 бит хватает на блок из
+// SCAN_BLOCK слагаемых по 96 бит
+typedef struct {
+  unsigned int bits[4];
+  int scale;
+} short_sum;
+
+// Элемент с недопустимым scale в сумму не входит
+static int scan_valid(s21_decimal value) { return get_scale(value) <= 28; }
+
+// Перевод в decimal без округления; 0, если модуль длиннее 96 бит
+static int short_store(const short_sum *sum, s21_decimal *result) {
+  unsigned int magnitude[4];
+  int sign = short_magnitude(sum->bits, magnitude);
+  if (magnitude[3] == 0) {
+    for (int i = 0; i < 3; i++) result->bits[i] = magnitude[i];
+    result->bits[3] = (unsigned int)sum->scale << 16;
+    if (sign) result->bits[3] |= 1u << 31;
+  }
+  return magnitude[3] == 0;
+}
+
+// Загрузка точной суммы, если она помещается в 96 бит с допустимым scale
+static int short_load(const s21_wide *value, short_sum *sum) {
+  int fits = value->scale >= 0 && value->scale <= 28 &&
+             wide_bit_length(value) <= 96;
+  if (fits) {
+    unsigned int mask = 0u - (unsigned int)value->sign;
+    unsigned long long carry = mask & 1;
+    for (int i = 0; i < 4; i++) {
+      carry += (i < 3 ? value->bits[i] : 0) ^ mask;
+      sum->bits[i] = (unsigned int)carry;
+      carry >>= 32;
+    }
+    sum->scale = value->scale;
+  }
+  return fits;
+}
+
+// Первый проход: точная сумма каждого блока. Слагаемые со scale первого
+// элемента идут в short_sum, остальные - в s21_wide
+static void sum_blocks(void *argument, size_t begin, size_t end) {
+  scan_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t first = block * SCAN_BLOCK;
+    size_t last = first + SCAN_BLOCK;
+    if (last > context->n) last = context->n;
+    short_sum sum = {{0}, get_scale(context->in[first])};
+    s21_wide rest = wide_zero();
+    for (size_t i = first; i < last; i++) {
+      s21_decimal value = context->in[i];
+      if (get_scale(value) == sum.scale) {
+        short_add(sum.bits, value);
+      } else if (scan_valid(value)) {
+        wide_add_decimal(&rest, value);
+      }
+    }
+    short_to_wide(sum.bits, sum.scale, &context->partials[block]);
+    if (sum.scale > 28) context->partials[block] = wide_zero();
+    wide_add(&context->partials[block], &rest);
+  }
+}
+
+// Нарастающая сумма [begin, end) от точного смещения acc. Пока сумма
+// помещается в decimal, она хранится в short_sum и каждый выход - копия
+// слов; иначе элемент проходит через s21_wide с округлением на выходе
+static void scan_range(scan_context *context, size_t begin, size_t end,
+                       s21_wide acc) {
+  short_sum sum;
+  int fast = short_load(&acc, &sum);
+  int failed = 0;
+  for (size_t i = begin; i < end; i++) {
+    s21_decimal value = context->in[i];
+    int code = CodeOK;
+    if (!scan_valid(value)) {
+      code = CodeInvalidData;
+    } else if (fast && get_scale(value) == sum.scale) {
+      short_add(sum.bits, value);
+      fast = short_store(&sum, &context->out[i]);
+      if (!fast) {
+        short_to_wide(sum.bits, sum.scale, &acc);
+        code = wide_to_decimal(&acc, S21_ROUND_HALF_EVEN, &context->out[i]);
+      }
+    } else {
+      if (fast) short_to_wide(sum.bits, sum.scale, &acc);
+      code = wide_add_decimal(&acc, value);
+      if (code == CodeOK) {
+        code = wide_to_decimal(&acc, S21_ROUND_HALF_EVEN, &context->out[i]);
+      }
+      fast = short_load(&acc, &sum);
+    }
+    if (code != CodeOK) context->out[i] = decimal_zero();
+    if (context->codes) context->codes[i] = code;
+    if (code != CodeOK && !failed) {
+      batch_note_error(&context->first_error, i, code);
+      failed = 1;
+    }
+  }
+}
+
+// Второй проход: выходы блоков от их смещений
+static void scan_blocks(void *argument, size_t begin, size_t end) {
+  scan_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t last = (block + 1) * SCAN_BLOCK;
+    if (last > context->n) last = context->n;
+    scan_range(context, block * SCAN_BLOCK, last, context->partials[block]);
+  }
+}
+
+int s21_prefix_sum(const s21_decimal *in, s21_decimal *out, size_t n,
+                   int *codes, const s21_exec_policy *policy) {
+  if (n > 0 && (!in || !out)) return CodeInvalidData;
+  scan_context context = {in, out, codes, n, NULL, BATCH_NO_ERROR};
+  size_t blocks = (n + SCAN_BLOCK - 1) / SCAN_BLOCK;
+  int status = CodeOK;
+  if (blocks <= 1 || !policy || policy->mode == S21_EXEC_SEQUENTIAL) {
+    // Один поток проходит массив один раз
+    scan_range(&context, 0, n, wide_zero());
+  } else {
+    context.partials = malloc(sizeof(s21_wide) * blocks);
+    if (!context.partials) status = CodeInvalidData;
+    if (status == CodeOK) {
+      status = s21_exec_for(policy, blocks, 1, sum_blocks, &context);
+    }
+    // Суммы блоков заменяются исключающими префиксами; блоков немного
+    s21_wide offset = wide_zero();
+    for (size_t block = 0; block < blocks && status == CodeOK; block++) {
+      s21_wide sum = context.partials[block];
+      context.partials[block] = offset;
+      status = wide_add(&offset, &sum);
+    }
+    if (status == CodeOK) {
+      status = s21_exec_for(policy, blocks, 1, scan_blocks, &context);
+    }
+    free(context.partials);
+  }
+  return (status == CodeOK) ? batch_error_code(context.first_error) : status;
+}
@@ -0,0 +1,510 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "s21_decimal_inline.h"
+
+// Элементов в блоке. Разбиение зависит только от n, поэтому частичные
+// результаты одинаковы при любом числе потоков
+#define BLOCK_SIZE 16384
+// Наибольший scale произведения двух decimal
+#define MAX_PRODUCT_SCALE 56
+// Слов в сумме блока: 192 бита произведения и 14 бит на BLOCK_SIZE слагаемых
+#define BUCKET_LIMBS 7
+
+// Точная сумма слагаемых блока с одинаковыми знаком и scale
+typedef struct {
+  unsigned int bits[BUCKET_LIMBS];
+  int used;
+} bucket;
+
+typedef struct {
+  bucket buckets[2][MAX_PRODUCT_SCALE + 1];
+} bucket_set;
+
+typedef void (*block_task)(void *context, size_t index);
+
+typedef struct {
+  const s21_decimal *a;
+  const s21_decimal *b;
+  size_t n;
+  int want_max;
+  block_task task;
+  s21_wide *partials;
+  s21_wide *weight_partials;  // суммы b по блокам (взвешенное среднее)
+  s21_decimal *extremes;
+  int *codes;
+} reduce_context;
+
+// Сумма произведений одной пары scale по столбцам: каждое 32-битное слово
+// произведения со знаком прибавляется к своему 64-битному столбцу без
+// переносов, а переносы разносятся один раз в конце блока. Столбец
+// получает не больше шести слов на элемент, на BLOCK_SIZE элементов запаса
+// хватает с избытком. Знак учитывается маской, без ветвлений
+typedef struct {
+  long long products[6];
+  long long weights[3];
+  int value_scale;
+  int weight_scale;
+} column_sum;
+
+static void bucket_add(bucket *target, const unsigned int *limbs, int count) {
+  unsigned long long carry = 0;
+  for (int i = 0; i < BUCKET_LIMBS && (i < count || carry); i++) {
+    carry += (unsigned long long)target->bits[i] + (i < count ? limbs[i] : 0);
+    target->bits[i] = (unsigned int)carry;
+    carry >>= 32;
+  }
+  target->used = 1;
+}
+
+// Сумма корзин блока в s21_wide (scale выравнивает wide_add)
+static int merge_buckets(const bucket_set *set, s21_wide *result) {
+  int status = CodeOK;
+  *result = wide_zero();
+  for (int sign = 0; sign < 2; sign++) {
+    for (int scale = 0; scale <= MAX_PRODUCT_SCALE && status == CodeOK;
+         scale++) {
+      const bucket *source = &set->buckets[sign][scale];
+      if (source->used) {
+        s21_wide value = wide_zero();
+        memcpy(value.bits, source->bits, sizeof(source->bits));
+        value.scale = scale;
+        value.sign = wide_is_zero(&value) ? 0 : sign;
+        status = wide_add(result, &value);
+      }
+    }
+  }
+  return status;
+}
+
+static void block_range(size_t n, size_t index, size_t *begin,
+                        size_t *end) {
+  *begin = index * BLOCK_SIZE;
+  *end = *begin + BLOCK_SIZE;
+  if (*end > n) *end = n;
+}
+
+static void sum_block(void *argument, size_t index) {
+  reduce_context *context = argument;
+  size_t begin = 0;
+  size_t end = 0;
+  block_range(context->n, index, &begin, &end);
+  bucket_set *set = calloc(1, sizeof(bucket_set));
+  int status = set ? CodeOK : CodeInvalidData;
+  for (size_t i = begin; i < end && status == CodeOK; i++) {
+    s21_decimal value = context->a[i];
+    int scale = get_scale(value);
+    if (scale > 28) {
+      status = CodeInvalidData;
+    } else {
+      bucket_add(&set->buckets[get_sign(value)][scale], value.bits, 3);
+    }
+  }
+  if (status == CodeOK) status = merge_buckets(set, &context->partials[index]);
+  context->codes[index] = status;
+  free(set);
+}
+
+// Слово со знаком: mask = 0 или -1
+static long long signed_word(unsigned int word, long long mask) {
+  return ((long long)word ^ mask) - mask;
+}
+
+static void column_add(column_sum *sum, s21_decimal x, s21_decimal y) {
+  long long mask = -(long long)((x.bits[3] ^ y.bits[3]) >> 31);
+  if (!(x.bits[1] | x.bits[2] | y.bits[1] | y.bits[2])) {
+    // Цены и количества обычно помещаются в одно слово
+    unsigned long long product = (unsigned long long)x.bits[0] * y.bits[0];
+    sum->products[0] += signed_word((unsigned int)product, mask);
+    sum->products[1] += signed_word((unsigned int)(product >> 32), mask);
+  } else {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        unsigned long long product =
+            (unsigned long long)x.bits[j] * y.bits[k];
+        sum->products[j + k] += signed_word((unsigned int)product, mask);
+        sum->products[j + k + 1] +=
+            signed_word((unsigned int)(product >> 32), mask);
+      }
+    }
+  }
+  long long weight_mask = -(long long)(y.bits[3] >> 31);
+  for (int i = 0; i < 3; i++) {
+    sum->weights[i] += signed_word(y.bits[i], weight_mask);
+  }
+}
+
+// Перенос по столбцам со знаком и добавление модуля в корзину своего знака
+static void columns_to_bucket(const long long *columns, int count,
+                              bucket *targets[2]) {
+  unsigned int limbs[BUCKET_LIMBS] = {0};
+  long long carry = 0;
+  for (int i = 0; i < BUCKET_LIMBS; i++) {
+    long long value = carry + ((i < count) ? columns[i] : 0);
+    limbs[i] = (unsigned int)value;
+    // Деление точное: value - limbs[i] кратно 2^32
+    carry = (value - (long long)limbs[i]) / 4294967296LL;
+  }
+  int sign = carry < 0;
+  if (sign) {
+    unsigned long long borrow = 1;
+    for (int i = 0; i < BUCKET_LIMBS; i++) {
+      borrow += (unsigned int)~limbs[i];
+      limbs[i] = (unsigned int)borrow;
+      borrow >>= 32;
+    }
+  }
+  bucket_add(targets[sign], limbs, BUCKET_LIMBS);
+}
+
+// Произведение мантисс 96 x 96 бит в шести словах
+static void product_bucket_add(bucket_set *set, s21_decimal x,
+                               s21_decimal y) {
+  unsigned int product[6] = {0};
+  for (int j = 0; j < 3; j++) {
+    unsigned long long carry = 0;
+    for (int k = 0; k < 3; k++) {
+      carry += (unsigned long long)x.bits[j] * y.bits[k] + product[j + k];
+      product[j + k] = (unsigned int)carry;
+      carry >>= 32;
+    }
+    product[j + 3] = (unsigned int)carry;
+  }
+  int sign = get_sign(x) ^ get_sign(y);
+  bucket_add(&set->buckets[sign][get_scale(x) + get_scale(y)], product, 6);
+}
+
+// Сумма x * y и сумма y по блоку. Пары со scale, как у первой пары блока
+// (частый случай), складываются по столбцам, остальные - в корзины по scale
+typedef struct {
+  column_sum columns;
+  bucket_set *products;
+  bucket_set *weights;
+} product_sum;
+
+static int product_sum_init(product_sum *sum, s21_decimal x, s21_decimal y) {
+  column_sum columns = {{0}, {0}, get_scale(x), get_scale(y)};
+  sum->columns = columns;
+  sum->products = calloc(1, sizeof(bucket_set));
+  sum->weights = calloc(1, sizeof(bucket_set));
+  return (sum->products && sum->weights) ? CodeOK : CodeInvalidData;
+}
+
+// x и y с допустимым scale
+static void product_sum_add(product_sum *sum, s21_decimal x, s21_decimal y) {
+  if (get_scale(x) == sum->columns.value_scale &&
+      get_scale(y) == sum->columns.weight_scale) {
+    column_add(&sum->columns, x, y);
+  } else {
+    product_bucket_add(sum->products, x, y);
+    bucket_add(&sum->weights->buckets[get_sign(y)][get_scale(y)], y.bits, 3);
+  }
+}
+
+// Итоги в s21_wide при status == CodeOK; память освобождается всегда
+static int product_sum_finish(product_sum *sum, int status,
+                              s21_wide *products, s21_wide *weights) {
+  if (status == CodeOK) {
+    column_sum *columns = &sum->columns;
+    int scale = columns->value_scale + columns->weight_scale;
+    bucket *product_targets[2] = {&sum->products->buckets[0][scale],
+                                  &sum->products->buckets[1][scale]};
+    bucket *weight_targets[2] = {
+        &sum->weights->buckets[0][columns->weight_scale],
+        &sum->weights->buckets[1][columns->weight_scale]};
+    columns_to_bucket(columns->products, 6, product_targets);
+    columns_to_bucket(columns->weights, 3, weight_targets);
+    status = merge_buckets(sum->products, products);
+  }
+  if (status == CodeOK) status = merge_buckets(sum->weights, weights);
+  free(sum->products);
+  free(sum->weights);
+  return status;
+}
+
+// Сумма a[i] * b[i] блока, а для взвешенного среднего и сумма b[i]
+static void dot_block(void *argument, size_t index) {
+  reduce_context *context = argument;
+  size_t begin = 0;
+  size_t end = 0;
+  block_range(context->n, index, &begin, &end);
+  product_sum sum;
+  int status = product_sum_init(&sum, context->a[begin], context->b[begin]);
+  for (size_t i = begin; i < end && status == CodeOK; i++) {
+    s21_decimal x = context->a[i];
+    s21_decimal y = context->b[i];
+    if (get_scale(x) > 28 || get_scale(y) > 28) {
+      status = CodeInvalidData;
+    } else {
+      product_sum_add(&sum, x, y);
+    }
+  }
+  s21_wide weights;
+  status = product_sum_finish(&sum, status, &context->partials[index],
+                              &weights);
+  if (status == CodeOK && context->weight_partials) {
+    context->weight_partials[index] = weights;
+  }
+  context->codes[index] = status;
+}
+
+// value_1 < value_2. При одинаковых scale и знаке (частый случай в
+// массиве) сравниваются мантиссы без выравнивания
+static int is_less(s21_decimal value_1, s21_decimal value_2) {
+  int less = 0;
+  if (value_1.bits[3] == value_2.bits[3]) {
+    int order = compare_magnitude(value_1, value_2);
+    less = get_sign(value_1) ? order > 0 : order < 0;
+  } else {
+    less = s21_is_less(value_1, value_2);
+  }
+  return less;
+}
+
+// Первый наименьший (наибольший) элемент блока; scale проверяется до
+// сравнения, как в sum_block
+static void extreme_block(void *argument, size_t index) {
+  reduce_context *context = argument;
+  size_t begin = 0;
+  size_t end = 0;
+  block_range(context->n, index, &begin, &end);
+  s21_decimal best = context->a[begin];
+  int status = (get_scale(best) > 28) ? CodeInvalidData : CodeOK;
+  for (size_t i = begin + 1; i < end && status == CodeOK; i++) {
+    s21_decimal value = context->a[i];
+    if (get_scale(value) > 28) {
+      status = CodeInvalidData;
+    } else if (context->want_max ? is_less(best, value)
+                                 : is_less(value, best)) {
+      best = value;
+    }
+  }
+  context->extremes[index] = best;
+  context->codes[index] = status;
+}
+
+// Блоки [begin, end) одного куска работы пула
+static void run_block_range(void *argument, size_t begin, size_t end) {
+  reduce_context *context = argument;
+  for (size_t i = begin; i < end; i++) context->task(context, i);
+}
+
+// Раздает блоки пулу по одному; частичные результаты - s21_wide
+// (wide != 0) или decimal. Возвращает число блоков или 0 при нехватке памяти
+static size_t run_blocks(reduce_context *context,
+                         const s21_exec_policy *policy, int wide,
+                         block_task task) {
+  size_t blocks = (context->n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  context->codes = malloc(sizeof(int) * blocks);
+  if (wide) {
+    context->partials = malloc(sizeof(s21_wide) * blocks);
+  } else {
+    context->extremes = malloc(sizeof(s21_decimal) * blocks);
+  }
+  if (!context->codes || (!context->partials && !context->extremes)) {
+    blocks = 0;
+  } else {
+    context->task = task;
+    s21_exec_for(policy, blocks, 1, run_block_range, context);
+  }
+  return blocks;
+}
+
+// Сумма частичных результатов в порядке блоков (и сумма весов, если
+// weight_total не NULL)
+static int reduce_totals(reduce_context *context,
+                         const s21_exec_policy *policy, block_task task,
+                         s21_wide *total, s21_wide *weight_total) {
+  int status = CodeOK;
+  *total = wide_zero();
+  if (weight_total) *weight_total = wide_zero();
+  if (weight_total && context->n > 0) {
+    size_t blocks = (context->n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    context->weight_partials = malloc(sizeof(s21_wide) * blocks);
+    if (!context->weight_partials) status = CodeInvalidData;
+  }
+  if (context->n > 0 && status == CodeOK) {
+    size_t blocks = run_blocks(context, policy, 1, task);
+    if (blocks == 0) status = CodeInvalidData;
+    for (size_t i = 0; i < blocks && status == CodeOK; i++) {
+      status = context->codes[i];
+      if (status == CodeOK) status = wide_add(total, &context->partials[i]);
+      if (status == CodeOK && weight_total) {
+        status = wide_add(weight_total, &context->weight_partials[i]);
+      }
+    }
+  }
+  free(context->codes);
+  free(context->partials);
+  free(context->weight_partials);
+  return status;
+}
+
+// Точная сумма и одно округление
+static int reduce_wide(reduce_context *context,
+                       const s21_exec_policy *policy, block_task task,
+                       s21_decimal *result) {
+  s21_wide total;
+  int status = reduce_totals(context, policy, task, &total, NULL);
+  if (status == CodeOK) {
+    status = wide_to_decimal(&total, S21_ROUND_HALF_EVEN, result);
+  }
+  return status;
+}
+
+// Из минимумов (максимумов) блоков берется первый: при равных значениях
+// с разной записью (1.0 и 1.00) ответ тоже не зависит от числа потоков.
+// Ошибка - код первого неудачного блока, как в reduce_totals; result
+// тогда не меняется
+static int reduce_extreme(reduce_context *context,
+                          const s21_exec_policy *policy,
+                          s21_decimal *result) {
+  int status = CodeInvalidData;
+  if (context->n > 0) {
+    size_t blocks = run_blocks(context, policy, 0, extreme_block);
+    s21_decimal best = {{0}};
+    if (blocks > 0) status = CodeOK;
+    for (size_t i = 0; i < blocks && status == CodeOK; i++) {
+      s21_decimal value = context->extremes[i];
+      status = context->codes[i];
+      if (status == CodeOK &&
+          (i == 0 || (context->want_max ? is_less(best, value)
+                                        : is_less(value, best)))) {
+        best = value;
+      }
+    }
+    if (status == CodeOK) *result = best;
+  }
+  free(context->codes);
+  free(context->extremes);
+  return status;
+}
+
+int s21_reduce_sum_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result) {
+  if (!result || (n > 0 && !values)) return CodeInvalidData;
+  reduce_context context = {values, NULL, n,    0,   NULL,
+                            NULL,   NULL, NULL, NULL};
+  return reduce_wide(&context, policy, sum_block, result);
+}
+
+int s21_reduce_dot_parallel(const s21_decimal *a, const s21_decimal *b,
+                            size_t n, const s21_exec_policy *policy,
+                            s21_decimal *result) {
+  if (!result || (n > 0 && (!a || !b))) return CodeInvalidData;
+  reduce_context context = {a, b, n, 0, NULL, NULL, NULL, NULL, NULL};
+  return reduce_wide(&context, policy, dot_block, result);
+}
+
+int s21_reduce_min_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result) {
+  if (!result || (n > 0 && !values)) return CodeInvalidData;
+  reduce_context context = {values, NULL, n,    0,   NULL,
+                            NULL,   NULL, NULL, NULL};
+  return reduce_extreme(&context, policy, result);
+}
+
+int s21_reduce_max_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result) {
+  if (!result || (n > 0 && !values)) return CodeInvalidData;
+  reduce_context context = {values, NULL, n,    1,   NULL,
+                            NULL,   NULL, NULL, NULL};
+  return reduce_extreme(&context, policy, result);
+}
+
+int s21_weighted_avg_n(const s21_decimal *values, const s21_decimal *weights,
+                       size_t n, int target_scale, s21_decimal *result,
+                       const s21_exec_policy *policy) {
+  if (!result || (n > 0 && (!values || !weights)) || target_scale < 0 ||
+      target_scale > 28) {
+    return CodeInvalidData;
+  }
+  reduce_context context = {values, weights, n,    0,   NULL,
+                            NULL,   NULL,    NULL, NULL};
+  s21_wide products;
+  s21_wide total_weight;
+  int status =
+      reduce_totals(&context, policy, dot_block, &products, &total_weight);
+  if (status == CodeOK) {
+    status = wide_div_to_decimal(&products, &total_weight, target_scale,
+                                 S21_ROUND_HALF_EVEN, result);
+  }
+  return status;
+}
+
+typedef struct {
+  const s21_decimal *x;
+  const s21_decimal *y;
+  size_t n;
+  s21_moments *partials;
+  int *codes;
+} moments_context;
+
+// Моменты блоков [begin, end) за один проход: x * x и x дает одна сумма
+// произведений, x * y и y - вторая
+static void moments_blocks(void *argument, size_t begin, size_t end) {
+  moments_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t first = 0;
+    size_t last = 0;
+    block_range(context->n, block, &first, &last);
+    const s21_decimal *x = context->x;
+    const s21_decimal *y = context->y;
+    s21_moments *moments = &context->partials[block];
+    s21_moments_init(moments);
+    moments->count = last - first;
+    product_sum squares;
+    product_sum cross = {{{0}, {0}, 0, 0}, NULL, NULL};
+    int status = product_sum_init(&squares, x[first], x[first]);
+    int cross_status =
+        y ? product_sum_init(&cross, x[first], y[first]) : CodeOK;
+    if (status == CodeOK) status = cross_status;
+    for (size_t i = first; i < last && status == CodeOK; i++) {
+      if (get_scale(x[i]) > 28 || (y && get_scale(y[i]) > 28)) {
+        status = CodeInvalidData;
+      } else {
+        product_sum_add(&squares, x[i], x[i]);
+        if (y) product_sum_add(&cross, x[i], y[i]);
+      }
+    }
+    status = product_sum_finish(&squares, status, &moments->sum_xx,
+                                &moments->sum_x);
+    if (y) {
+      status = product_sum_finish(&cross, status, &moments->sum_xy,
+                                  &moments->sum_y);
+    } else {
+      moments->sum_xy = moments->sum_xx;
+      moments->sum_y = moments->sum_x;
+    }
+    context->codes[block] = status;
+  }
+}
+
+int s21_moments_n(const s21_decimal *x, const s21_decimal *y, size_t n,
+                  s21_moments *result, const s21_exec_policy *policy) {
+  if (!result || (n > 0 && !x)) return CodeInvalidData;
+  s21_moments_init(result);
+  size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  moments_context context = {x, y, n, NULL, NULL};
+  int status = CodeOK;
+  if (blocks > 0) {
+    context.partials = malloc(sizeof(s21_moments) * blocks);
+    context.codes = malloc(sizeof(int) * blocks);
+    if (!context.partials || !context.codes) status = CodeInvalidData;
+  }
+  if (status == CodeOK) {
+    status = s21_exec_for(policy, blocks, 1, moments_blocks, &context);
+  }
+  for (size_t i = 0; i < blocks && status == CodeOK; i++) {
+    status = context.codes[i];
+    if (status == CodeOK) {
+      status = s21_moments_merge(result, &context.partials[i]);
+    }
+  }
+  free(context.partials);
+  free(context.codes);
+  return status;
+}
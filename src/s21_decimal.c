@@ -1,4 +1,4 @@
-#include "s21_decimal.h"
+#include "s21_decimal_inline.h"
 
 // Файл содержит вспомогательные функции, которые используются интерфейсными
 // функциями
@@ -9,70 +9,81 @@ s21_decimal decimal_zero() {
   return result;
 }
 
-// Проверка на ноль
-int is_zero(s21_decimal value) {
-  return (value.bits[0] == 0 && value.bits[1] == 0 && value.bits[2] == 0);
+// Таблица степеней десяти, помещающихся в 96-битную мантиссу
+static const s21_decimal pow10_table[29] = {
+    {{0x00000001, 0x00000000, 0x00000000, 0}},  // 1e0
+    {{0x0000000A, 0x00000000, 0x00000000, 0}},  // 1e1
+    {{0x00000064, 0x00000000, 0x00000000, 0}},  // 1e2
+    {{0x000003E8, 0x00000000, 0x00000000, 0}},  // 1e3
+    {{0x00002710, 0x00000000, 0x00000000, 0}},  // 1e4
+    {{0x000186A0, 0x00000000, 0x00000000, 0}},  // 1e5
+    {{0x000F4240, 0x00000000, 0x00000000, 0}},  // 1e6
+    {{0x00989680, 0x00000000, 0x00000000, 0}},  // 1e7
+    {{0x05F5E100, 0x00000000, 0x00000000, 0}},  // 1e8
+    {{0x3B9ACA00, 0x00000000, 0x00000000, 0}},  // 1e9
+    {{0x540BE400, 0x00000002, 0x00000000, 0}},  // 1e10
+    {{0x4876E800, 0x00000017, 0x00000000, 0}},  // 1e11
+    {{0xD4A51000, 0x000000E8, 0x00000000, 0}},  // 1e12
+    {{0x4E72A000, 0x00000918, 0x00000000, 0}},  // 1e13
+    {{0x107A4000, 0x00005AF3, 0x00000000, 0}},  // 1e14
+    {{0xA4C68000, 0x00038D7E, 0x00000000, 0}},  // 1e15
+    {{0x6FC10000, 0x002386F2, 0x00000000, 0}},  // 1e16
+    {{0x5D8A0000, 0x01634578, 0x00000000, 0}},  // 1e17
+    {{0xA7640000, 0x0DE0B6B3, 0x00000000, 0}},  // 1e18
+    {{0x89E80000, 0x8AC72304, 0x00000000, 0}},  // 1e19
+    {{0x63100000, 0x6BC75E2D, 0x00000005, 0}},  // 1e20
+    {{0xDEA00000, 0x35C9ADC5, 0x00000036, 0}},  // 1e21
+    {{0xB2400000, 0x19E0C9BA, 0x0000021E, 0}},  // 1e22
+    {{0xF6800000, 0x02C7E14A, 0x0000152D, 0}},  // 1e23
+    {{0xA1000000, 0x1BCECCED, 0x0000D3C2, 0}},  // 1e24
+    {{0x4A000000, 0x16140148, 0x00084595, 0}},  // 1e25
+    {{0xE4000000, 0xDCC80CD2, 0x0052B7D2, 0}},  // 1e26
+    {{0xE8000000, 0x9FD0803C, 0x033B2E3C, 0}},  // 1e27
+    {{0x10000000, 0x3E250261, 0x204FCE5E, 0}},  // 1e28
+};
+
+// Получение 10^power (0 <= power <= 28) в виде мантиссы decimal
+s21_decimal decimal_pow10(int power) {
+  s21_decimal result = decimal_zero();
+  if (power >= 0 && power <= 28) result = pow10_table[power];
+  return result;
 }
 
+// Внешние версии помощников из s21_decimal_inline.h (ради ABI). Имена в
+// скобках, чтобы не раскрывались макросы заголовка
+
+// Проверка на ноль
+int(is_zero)(s21_decimal value) { return is_zero_inline(value); }
+
 // Получение значения бита по номеру bit
-int get_bit(s21_decimal number, int bit) {
-  int discharge = bit / 32;
-  int bitPosition = bit % 32;
-  return (number.bits[discharge] >> bitPosition) & 1;
+int(get_bit)(s21_decimal number, int bit) {
+  return get_bit_inline(number, bit);
 }
 
 // Установка значения бита по номеру bit на знак sign
-void set_bit(s21_decimal *number, int bit, int sign) {
-  int discharge = bit / 32;
-  int bitPosition = bit % 32;
-  if (sign == 0) {
-    number->bits[discharge] &= ~(1u << bitPosition);
-  } else {
-    number->bits[discharge] |= (1u << bitPosition);
-  }
+void(set_bit)(s21_decimal *number, int bit, int sign) {
+  set_bit_inline(number, bit, sign);
 }
 
 // Получение знака числа
-int get_sign(s21_decimal number) { return (number.bits[3] >> 31) & 1; }
+int(get_sign)(s21_decimal number) { return get_sign_inline(number); }
 
 // Установка знака числа (0 - положительное, 1 - отрицательное)
-void set_sign(s21_decimal *number, int sign) {
-  if (number != NULL) {
-    if (sign == 1) {
-      number->bits[3] |= (1u << 31);
-    } else {
-      number->bits[3] &= ~(1u << 31);
-    }
-  }
+void(set_sign)(s21_decimal *number, int sign) {
+  set_sign_inline(number, sign);
 }
 
 // Получение масштаба числа
-int get_scale(s21_decimal number) { return (number.bits[3] >> 16) & 0xFF; }
+int(get_scale)(s21_decimal number) { return get_scale_inline(number); }
 
 // Установка масштаба числа
-void set_scale(s21_decimal *number, int scale) {
-  if (number != NULL && scale >= 0 && scale <= 28) {
-    number->bits[3] &= ~(0xFF << 16);
-    number->bits[3] |= (scale << 16);
-  }
+void(set_scale)(s21_decimal *number, int scale) {
+  set_scale_inline(number, scale);
 }
 
 // Сравнение по модулю (без учета знака и порядка!)
-int compare_magnitude(s21_decimal value_1, s21_decimal value_2) {
-  int result = 0;
-
-  int flag = 0;
-  for (int i = 2; i >= 0 && !flag; i--) {
-    if (value_1.bits[i] > value_2.bits[i]) {
-      result = 1;
-      flag = 1;
-    } else if (value_1.bits[i] < value_2.bits[i]) {
-      result = -1;
-      flag = 1;
-    }
-  }
-
-  return result;
+int(compare_magnitude)(s21_decimal value_1, s21_decimal value_2) {
+  return compare_magnitude_inline(value_1, value_2);
 }
 
 // Сложение для мантиссы + 1 (используется при округлении)
@@ -100,58 +111,222 @@ void s21_bank_rounding(s21_decimal *val, int remainder) {
   }
 }
 
-// Нормализация с банковским округлением (для удаления лишних нулей)
+// Степени десяти, помещающиеся в 32 бита
+static const unsigned int pow10_u32[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+// Деление многословного числа (младшее слово первым) на 32-битный делитель,
+// возвращает остаток
+unsigned int limbs_div_u32(unsigned int *limbs, int count,
+                           unsigned int divisor) {
+  unsigned long long remainder = 0;
+  for (int i = count - 1; i >= 0; i--) {
+    unsigned long long cur = limbs[i] + (remainder << 32);
+    limbs[i] = (unsigned int)(cur / divisor);
+    remainder = cur % divisor;
+  }
+  return (unsigned int)remainder;
+}
+
+// Умножение многословного числа на 32-битный множитель, возвращает перенос
+unsigned int limbs_mul_u32(unsigned int *limbs, int count,
+                           unsigned int factor) {
+  unsigned long long carry = 0;
+  for (int i = 0; i < count; i++) {
+    unsigned long long cur = (unsigned long long)limbs[i] * factor + carry;
+    limbs[i] = (unsigned int)cur;
+    carry = cur >> 32;
+  }
+  return (unsigned int)carry;
+}
+
+// Прибавление единицы, возвращает перенос из старшего слова
+int limbs_increment(unsigned int *limbs, int count) {
+  int carry = 1;
+  for (int i = 0; i < count && carry; i++) {
+    limbs[i]++;
+    carry = (limbs[i] == 0);
+  }
+  return carry;
+}
+
+// Деление на 10^power за ceil(power / 9) проходов вместо power делений на 10.
+// Возвращает guard-цифру (старшую из отброшенных), в sticky пишется 1, если
+// среди остальных отброшенных цифр есть ненулевые
+int limbs_div_pow10(unsigned int *limbs, int count, int power, int *sticky) {
+  int guard = 0;
+  *sticky = 0;
+  while (power > 9) {
+    if (limbs_div_u32(limbs, count, pow10_u32[9]) != 0) *sticky = 1;
+    power -= 9;
+  }
+  if (power > 0) {
+    unsigned int rem = limbs_div_u32(limbs, count, pow10_u32[power]);
+    guard = (int)(rem / pow10_u32[power - 1]);
+    if (rem % pow10_u32[power - 1] != 0) *sticky = 1;
+  }
+  return guard;
+}
+
+// Умножение на 10^power, возвращает CodeBigNumber при переполнении
+int limbs_mul_pow10(unsigned int *limbs, int count, int power) {
+  int status = CodeOK;
+  while (power > 0 && status == CodeOK) {
+    int step = (power > 9) ? 9 : power;
+    if (limbs_mul_u32(limbs, count, pow10_u32[step]) != 0) {
+      status = CodeBigNumber;
+    }
+    power -= step;
+  }
+  return status;
+}
+
+// Нужно ли увеличить усеченную мантиссу на единицу в режиме mode.
+// half_cmp - сравнение отброшенной части с половиной единицы младшего
+// разряда (-1, 0, 1), inexact - отброшенная часть не ноль,
+// odd - нечетность усеченной мантиссы, sign - знак числа
+int rounding_increment_by_half(int half_cmp, int inexact, int odd, int sign,
+                               s21_rounding_mode mode) {
+  int increment = 0;
+  switch (mode) {
+    case S21_ROUND_HALF_EVEN:
+      increment = (half_cmp > 0 || (half_cmp == 0 && odd));
+      break;
+    case S21_ROUND_HALF_UP:
+      increment = (half_cmp >= 0);
+      break;
+    case S21_ROUND_HALF_DOWN:
+      increment = (half_cmp > 0);
+      break;
+    case S21_ROUND_FLOOR:
+      increment = (inexact && sign);
+      break;
+    case S21_ROUND_CEILING:
+      increment = (inexact && !sign);
+      break;
+    case S21_ROUND_AWAY_FROM_ZERO:
+      increment = inexact;
+      break;
+    default:  // S21_ROUND_TRUNCATE
+      break;
+  }
+  return increment;
+}
+
+// То же по guard-цифре (первой отброшенной) и sticky-признаку хвоста
+int rounding_increment(int guard, int sticky, int odd, int sign,
+                       s21_rounding_mode mode) {
+  int half_cmp = (guard > 5 || (guard == 5 && sticky)) ? 1
+                 : (guard == 5)                        ? 0
+                                                       : -1;
+  return rounding_increment_by_half(half_cmp, guard != 0 || sticky, odd, sign,
+                                    mode);
+}
+
+// Количество десятичных цифр мантиссы (у нуля одна цифра).
+// Длина в битах дает оценку floor(bits * log10(2)) через bits * 1233 >> 12,
+// которая уточняется одним сравнением с 10^t из таблицы
+int s21_digit_count(s21_decimal value) {
+  int bits = 0;
+  for (int i = 2; i >= 0 && bits == 0; i--) {
+    if (value.bits[i] != 0) bits = 32 * i + 32 - __builtin_clz(value.bits[i]);
+  }
+  int digits = 1;
+  if (bits > 0) {
+    int estimate = (bits * 1233) >> 12;
+    digits = estimate + (compare_magnitude(value, pow10_table[estimate]) >= 0);
+  }
+  return digits;
+}
+
+// Отбрасывание хвостовых нулей мантиссы, но не больше limit штук.
+// Двоичный подъем: пробуем делители 10^16, 10^8, 10^4, 10^2, 10^1, так что
+// нужно не больше пяти проверок вместо одной проверки на каждый ноль.
+// Делимость на 10^k требует k нулевых младших бит - это отсекает большинство
+// проверок без деления. Возвращает количество отброшенных нулей
+static int strip_trailing_zeros(s21_decimal *value, int limit) {
+  int removed = 0;
+  for (int step = 16; step > 0; step /= 2) {
+    if (removed + step <= limit) {
+      unsigned int low_mask = (step >= 32) ? 0xFFFFFFFFu : (1u << step) - 1;
+      if ((value->bits[0] & low_mask) == 0) {
+        s21_decimal temp = *value;
+        int sticky = 0;
+        if (limbs_div_pow10(temp.bits, 3, step, &sticky) == 0 && !sticky) {
+          for (int i = 0; i < 3; i++) value->bits[i] = temp.bits[i];
+          removed += step;
+        }
+      }
+    }
+  }
+  return removed;
+}
+
+// Количество хвостовых десятичных нулей мантиссы (у нуля - 0)
+int s21_trailing_zeros(s21_decimal value) {
+  int zeros = 0;
+  if (!is_zero(value)) zeros = strip_trailing_zeros(&value, 28);
+  return zeros;
+}
+
+// Нормализация (удаление лишних нулей дробной части) за O(log scale) проверок
 void normalize(s21_decimal *value) {
   int scale = get_scale(*value);
-  int flag = 0;
-  while (scale > 0 && !flag) {
-    s21_decimal temp = *value;
-    int remainder = div_by_10(&temp);
-    if (remainder == 0) {
-      *value = temp;
-      scale--;
-      set_scale(value, scale);
-    } else {
-      flag = 1;
+  if (scale > 0) {
+    int removed = strip_trailing_zeros(value, scale);
+    set_scale(value, scale - removed);
+  }
+}
+
+// Повышение scale числа в сторону target без потери точности: сразу на
+// столько разрядов, сколько помещается в мантиссу. Запас оценивается по
+// количеству цифр: m < 10^d, поэтому m * 10^(28 - d) точно помещается.
+// Возвращает достигнутый scale
+static int raise_scale(s21_decimal *number, int scale, int target) {
+  s21_decimal temp = *number;
+  if (limbs_mul_pow10(temp.bits, 3, target - scale) == CodeOK) {
+    scale = target;
+  } else {
+    temp = *number;
+    int safe = 28 - s21_digit_count(temp);
+    if (safe > 0) {
+      limbs_mul_pow10(temp.bits, 3, safe);
+      scale += safe;
+    }
+    s21_decimal next = temp;
+    while (scale < target && limbs_mul_u32(next.bits, 3, 10) == 0) {
+      temp = next;
+      scale++;
     }
   }
+  for (int i = 0; i < 3; i++) number->bits[i] = temp.bits[i];
+  set_scale(number, scale);
+  return scale;
 }
 
 // Выравнивание масштабов с банковским округлением при потере точности
 int align_scale(s21_decimal *number1, s21_decimal *number2) {
   int scale1 = get_scale(*number1);
   int scale2 = get_scale(*number2);
-  if (scale1 == scale2) return CodeOK;
+  if (scale1 == scale2) {
+    S21_STAT_INC(S21_STAT_ALIGN_SAME_SCALE);
+    return CodeOK;
+  }
 
-  int flag = 0;
   // Сначала пытаемся привести к большему scale (умножением)
-  while (scale1 != scale2 && !flag) {
-    if (scale1 < scale2) {
-      s21_decimal temp = *number1;
-      // Пробуем умножить на 10
-      if (mul_by_10(&temp) == CodeOK) {
-        *number1 = temp;
-        scale1++;
-        set_scale(number1, scale1);
-      } else {
-        // Переполнение при повышении scale1.
-        // Придется уменьшать scale2.
-        flag = 1;
-      }
-    } else {  // scale1 > scale2
-      s21_decimal temp = *number2;
-      if (mul_by_10(&temp) == CodeOK) {
-        *number2 = temp;
-        scale2++;
-        set_scale(number2, scale2);
-      } else {
-        flag = 1;
-      }
-    }
+  if (scale1 < scale2) {
+    scale1 = raise_scale(number1, scale1, scale2);
+  } else {
+    scale2 = raise_scale(number2, scale2, scale1);
   }
 
   // Если scales все еще не равны (достигли переполнения), уменьшаем больший
   // scale используя банковское округление
+  if (scale1 != scale2) {
+    S21_STAT_INC(S21_STAT_ALIGN_LOSSY);
+    S21_STAT_ADD(S21_STAT_ALIGN_LOSSY_DIGITS,
+                 scale1 > scale2 ? scale1 - scale2 : scale2 - scale1);
+  }
   while (scale1 != scale2) {
     if (scale1 > scale2) {
       int remainder = div_by_10(number1);
@@ -1,6 +1,8 @@
 #ifndef S21_DECIMAL_H
 #define S21_DECIMAL_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 // от 79,228,162,514,264,337,593,543,950,335 до
@@ -33,18 +35,124 @@ typedef struct {
   unsigned int bits[4];
 } s21_decimal;
 
+// Широкое число для точных промежуточных вычислений: модуль до 512 бит,
+// знак и scale без ограничения 0..28 (может быть и отрицательным)
+#define S21_WIDE_LIMBS 16
+typedef struct {
+  unsigned int bits[S21_WIDE_LIMBS];  // модуль, младшее слово первым
+  int scale;                          // значение = bits / 10^scale
+  int sign;                           // 0 = +, 1 = -
+} s21_wide;
+
 #define CodeOK 0
 #define CodeBigNumber 1
 #define CodeSmallNumber 2
 #define CodeDivisionZero 3
 #define CodeInvalidData -1
 
+// Режимы округления
+typedef enum {
+  S21_ROUND_HALF_EVEN,       // к ближайшему, 0.5 - к четному (банковское)
+  S21_ROUND_HALF_UP,         // к ближайшему, 0.5 - от нуля
+  S21_ROUND_HALF_DOWN,       // к ближайшему, 0.5 - к нулю
+  S21_ROUND_FLOOR,           // к минус бесконечности
+  S21_ROUND_CEILING,         // к плюс бесконечности
+  S21_ROUND_TRUNCATE,        // к нулю
+  S21_ROUND_AWAY_FROM_ZERO,  // от нуля
+} s21_rounding_mode;
+
+// Политика выполнения пакетных функций (pool.c). NULL равносилен
+// S21_EXEC_SEQUENTIAL. threads - число участников вместе с вызывающим
+// потоком (0 - по числу ядер для встроенного пула или размер пула pool)
+typedef enum {
+  S21_EXEC_SEQUENTIAL,  // в вызывающем потоке
+  S21_EXEC_PARALLEL,    // на встроенном пуле, общем для всей библиотеки
+  S21_EXEC_POOL,        // на пуле pool, созданном s21_pool_create
+} s21_exec_mode;
+
+typedef struct s21_pool s21_pool;
+
+typedef struct {
+  s21_exec_mode mode;
+  int threads;
+  s21_pool *pool;
+} s21_exec_policy;
+
+// Публичный API экспортируется из разделяемой библиотеки и при сборке с
+// -fvisibility=hidden (make shared), вспомогательные функции ниже - нет
+#if defined(__GNUC__)
+#pragma GCC visibility push(default)
+#endif
+
 // Арифметические операторы
 int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_sub(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_div(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 
+// Те же операции с входами по указателю (result может совпадать с входом)
+int s21_add_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result);
+int s21_sub_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result);
+int s21_mul_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result);
+int s21_div_ref(const s21_decimal *value_1, const s21_decimal *value_2,
+                s21_decimal *result);
+// На месте: acc = acc op value; при ненулевом коде acc не меняется
+int s21_add_assign(s21_decimal *acc, const s21_decimal *value);
+int s21_sub_assign(s21_decimal *acc, const s21_decimal *value);
+int s21_mul_assign(s21_decimal *acc, const s21_decimal *value);
+int s21_div_assign(s21_decimal *acc, const s21_decimal *value);
+
+// Смешанная арифметика decimal и целого числа (без перевода числа в decimal)
+int s21_add_i64(s21_decimal value, int64_t number, s21_decimal *result);
+int s21_sub_i64(s21_decimal value, int64_t number, s21_decimal *result);
+int s21_mul_i64(s21_decimal value, int64_t number, s21_decimal *result);
+int s21_div_i64(s21_decimal value, int64_t number, s21_decimal *result);
+
+// Пакетные версии: result[i] = values[i] op numbers[i].
+// В codes (если не NULL) пишется код возврата для каждого элемента,
+// функция возвращает код элемента с наименьшим индексом среди ошибочных
+// или CodeOK. Так же устроены остальные пакетные функции с policy
+int s21_add_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy);
+int s21_sub_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy);
+int s21_mul_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy);
+int s21_div_i64_n(const s21_decimal *values, const int64_t *numbers,
+                  s21_decimal *result, int *codes, size_t n,
+                  const s21_exec_policy *policy);
+
+// Степени (n * 10^-59 - граница относительной ошибки до финального
+// округления, подробнее в powers.c)
+int s21_pow_int(s21_decimal base, int exponent, s21_decimal *result);
+// principal * (1 + rate)^periods с одним округлением
+int s21_compound(s21_decimal principal, s21_decimal rate, int periods,
+                 s21_decimal *result);
+int s21_compound_n(const s21_decimal *principal, const s21_decimal *rate,
+                   const int *periods, s21_decimal *out, int *codes,
+                   size_t n, const s21_exec_policy *policy);
+
+// Корень и трансцендентные функции (результат округляется один раз,
+// подробнее в transcendental.c)
+int s21_sqrt(s21_decimal value, s21_decimal *result);
+int s21_exp(s21_decimal value, s21_decimal *result);
+int s21_ln(s21_decimal value, s21_decimal *result);
+int s21_log10(s21_decimal value, s21_decimal *result);
+int s21_sqrt_n(const s21_decimal *in, s21_decimal *out, int *codes,
+               size_t n, const s21_exec_policy *policy);
+int s21_exp_n(const s21_decimal *in, s21_decimal *out, int *codes, size_t n,
+              const s21_exec_policy *policy);
+int s21_ln_n(const s21_decimal *in, s21_decimal *out, int *codes, size_t n,
+             const s21_exec_policy *policy);
+int s21_log10_n(const s21_decimal *in, s21_decimal *out, int *codes,
+                size_t n, const s21_exec_policy *policy);
+
 // Операторы сравнения
 int s21_is_less(s21_decimal value_1, s21_decimal value_2);
 int s21_is_less_or_equal(s21_decimal value_1, s21_decimal value_2);
@@ -64,9 +172,464 @@ int s21_floor(s21_decimal value, s21_decimal *result);
 int s21_round(s21_decimal value, s21_decimal *result);
 int s21_truncate(s21_decimal value, s21_decimal *result);
 int s21_negate(s21_decimal value, s21_decimal *result);
+int s21_ceil(s21_decimal value, s21_decimal *result);
+// Приведение к масштабу target_scale (0..28) с округлением в режиме mode;
+// для value с недопустимым scale - CodeInvalidData
+int s21_rescale(s21_decimal value, int target_scale, s21_rounding_mode mode,
+                s21_decimal *result);
+// Пакетное приведение к масштабу scale (например, к минимальной единице
+// валюты). В codes (если не NULL) пишется код для каждого элемента,
+// возвращается первый ненулевой код или CodeOK. in и out могут совпадать
+int s21_quantize_n(const s21_decimal *in, s21_decimal *out, size_t n,
+                   int scale, s21_rounding_mode mode, int *codes,
+                   const s21_exec_policy *policy);
+
+// Свойства мантиссы
+int s21_digit_count(s21_decimal value);
+int s21_trailing_zeros(s21_decimal value);
+
+// Атомарный decimal (atomic.c): 16-байтное значение меняется одним CAS
+// (cmpxchg16b через libatomic, при линковке нужен -latomic). Сложение с
+// тем же scale и знаком считается прямо в цикле CAS, остальные случаи -
+// через s21_add с его округлением. При ошибке значение не меняется
+typedef struct {
+  _Alignas(16) s21_decimal value;
+} s21_atomic_decimal;
+
+void s21_atomic_init(s21_atomic_decimal *target, s21_decimal value);
+s21_decimal s21_atomic_load(const s21_atomic_decimal *target);
+void s21_atomic_store(s21_atomic_decimal *target, s21_decimal value);
+// Записывает value и возвращает прежнее значение
+s21_decimal s21_atomic_exchange(s21_atomic_decimal *target,
+                                s21_decimal value);
+int s21_atomic_add(s21_atomic_decimal *target, s21_decimal value);
+
+// Шардированная сумма (sharded.c): у каждого потока свой слот с широким
+// аккумулятором на отдельной кэш-линии, сложение идет без атомарных
+// операций. Чтение складывает слоты и округляет один раз, поэтому итог
+// точен и не зависит от того, сколько потоков и в каком порядке добавляли.
+// В один слот пишет только один поток (номер слота выбирает вызывающий)
+#define S21_CACHE_LINE 64
+
+typedef struct {
+  _Alignas(S21_CACHE_LINE) unsigned int sequence;  // нечетное - идет запись
+  int status;                                      // первая ошибка слота
+  s21_wide value;
+} s21_sharded_slot;
+
+typedef struct {
+  s21_sharded_slot *slots;
+  size_t count;
+} s21_sharded_sum;
+
+int s21_sharded_init(s21_sharded_sum *sum, size_t shards);
+void s21_sharded_free(s21_sharded_sum *sum);
+int s21_sharded_add(s21_sharded_sum *sum, size_t shard, s21_decimal value);
+// Итог по всем слотам с округлением в режиме mode. Можно вызывать во время
+// записи: слот, который меняется, перечитывается
+int s21_sharded_read(const s21_sharded_sum *sum, s21_rounding_mode mode,
+                     s21_decimal *result);
+// Обнуление всех слотов (писатели в это время должны стоять)
+void s21_sharded_reset(s21_sharded_sum *sum);
+
+// Скользящее окно (window.c) для сумм, средних и VWAP. Суммы значений,
+// весов и произведений значение x вес хранятся точно в s21_wide, поэтому
+// push и evict стоят O(1), а push и evict одного значения возвращают окно
+// в прежнее состояние вместе со scale сумм. Окно по количеству (limit > 0)
+// при переполнении само вытесняет самый старый элемент, окно по времени
+// (limit = 0) растет, а старые элементы убирает s21_window_evict_before.
+// Если push или evict вернули ошибку, окно не меняется
+#define S21_WINDOW_SCALES 57  // scale произведения - до 56
+
+typedef struct {
+  s21_wide sum;
+  size_t scales[S21_WINDOW_SCALES];  // сколько слагаемых с каждым scale
+} s21_window_total;
+
+typedef struct {
+  int64_t time;
+  s21_decimal value;
+  s21_decimal weight;
+} s21_window_entry;
+
+typedef struct {
+  s21_window_entry *entries;  // кольцевой буфер, head - самый старый
+  size_t head;
+  size_t count;
+  size_t capacity;
+  size_t limit;
+  s21_window_total values;
+  s21_window_total weights;
+  s21_window_total products;
+} s21_window;
+
+int s21_window_init(s21_window *window, size_t limit);
+void s21_window_free(s21_window *window);
+void s21_window_reset(s21_window *window);
+int s21_window_push(s21_window *window, int64_t time, s21_decimal value,
+                    s21_decimal weight);
+// Убирает самый старый элемент (CodeInvalidData, если окно пусто)
+int s21_window_evict(s21_window *window);
+// Убирает элементы со временем меньше time
+int s21_window_evict_before(s21_window *window, int64_t time);
+size_t s21_window_count(const s21_window *window);
+// Суммы округляются один раз, среднее и VWAP (сумма произведений на
+// сумму весов) считаются по ним через s21_div. Для пустого окна среднее и
+// VWAP возвращают CodeDivisionZero
+int s21_window_sum(const s21_window *window, s21_decimal *result);
+int s21_window_mean(const s21_window *window, s21_decimal *result);
+int s21_window_vwap(const s21_window *window, s21_decimal *result);
+
+// Пул потоков с кражей работы (pool.c). У каждого участника своя очередь
+// блоков; опустевший участник забирает половину чужой очереди. Рабочие
+// потоки создаются при первой работе, которой они нужны, и живут до
+// s21_pool_destroy (встроенный пул - до s21_pool_shutdown)
+#define S21_POOL_MAX_THREADS 256
+
+// Пул на threads участников (0 - по числу ядер), NULL при ошибке
+s21_pool *s21_pool_create(int threads);
+void s21_pool_destroy(s21_pool *pool);
+int s21_pool_default_threads(void);
+// Останавливает встроенный пул (следующая работа запустит его заново)
+void s21_pool_shutdown(void);
+
+// Оценки стоимости одного элемента в наносекундах. По ним выбирается
+// размер блока, чтобы блок занимал около S21_EXEC_CHUNK_NS
+#define S21_EXEC_CHUNK_NS 50000
+#define S21_COST_ADD 60
+#define S21_COST_MUL 80
+#define S21_COST_DIV 300
+#define S21_COST_QUANTIZE 30
+#define S21_COST_COMPOUND 2000
+#define S21_COST_TRANSCENDENTAL 5000
+
+typedef void (*s21_range_task)(void *context, size_t begin, size_t end);
+
+// Выполняет task над [0, n), разбитым на блоки по grain элементов, и ждет
+// завершения. При последовательной политике task вызывается один раз на
+// весь диапазон. Вложенный вызов из потока пула тоже идет последовательно
+int s21_exec_for(const s21_exec_policy *policy, size_t n, size_t grain,
+                 s21_range_task task, void *context);
+// Размер блока для элементов стоимостью cost_ns
+size_t s21_exec_grain(size_t cost_ns);
+
+// Детерминированные параллельные свертки (reduce.c). Массив делится на
+// блоки фиксированного размера, каждый блок считается точно в s21_wide, а
+// итог округляется один раз (банковское округление, как в s21_add).
+// Результат не зависит от политики и числа потоков. Для пустого массива
+// сумма и скалярное произведение равны 0, а min и max возвращают
+// CodeInvalidData
+int s21_reduce_sum_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result);
+int s21_reduce_min_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result);
+int s21_reduce_max_parallel(const s21_decimal *values, size_t n,
+                            const s21_exec_policy *policy,
+                            s21_decimal *result);
+// Сумма a[i] * b[i]
+int s21_reduce_dot_parallel(const s21_decimal *a, const s21_decimal *b,
+                            size_t n, const s21_exec_policy *policy,
+                            s21_decimal *result);
+// Взвешенное среднее (VWAP) sum(values[i] * weights[i]) / sum(weights[i])
+// со scale target_scale (0..28). Произведения не округляются, деление и
+// округление (банковское) - одно на весь массив; если среднее со scale
+// target_scale не помещается в decimal, scale уменьшается. При нулевой
+// сумме весов (и для пустого массива) возвращается CodeDivisionZero
+int s21_weighted_avg_n(const s21_decimal *values, const s21_decimal *weights,
+                       size_t n, int target_scale, s21_decimal *result,
+                       const s21_exec_policy *policy);
+
+// Точные моменты (moments.c): количество, суммы x и y, сумма квадратов x
+// и сумма произведений x * y в s21_wide. Моменты можно набирать по одной
+// паре или по массиву (s21_moments_n, параллельно по политике) и
+// складывать. Среднее, дисперсия и ковариация считаются по ним одним
+// делением с банковским округлением до scale (0..28); sample = 1 дает
+// выборочные оценки (деление на n - 1), 0 - по генеральной совокупности
+typedef struct {
+  size_t count;
+  s21_wide sum_x;
+  s21_wide sum_y;
+  s21_wide sum_xx;
+  s21_wide sum_xy;
+} s21_moments;
+
+void s21_moments_init(s21_moments *moments);
+int s21_moments_add(s21_moments *moments, s21_decimal x, s21_decimal y);
+int s21_moments_merge(s21_moments *moments, const s21_moments *other);
+// Моменты массивов x и y (reduce.c); y = NULL - моменты одного x (y = x)
+int s21_moments_n(const s21_decimal *x, const s21_decimal *y, size_t n,
+                  s21_moments *result, const s21_exec_policy *policy);
+// При count <= sample (и для пустых моментов) - CodeDivisionZero
+int s21_moments_mean(const s21_moments *moments, int scale,
+                     s21_decimal *result);
+int s21_moments_variance(const s21_moments *moments, int sample, int scale,
+                         s21_decimal *result);
+// Корень из точной дисперсии, округленный один раз до scale
+int s21_moments_stddev(const s21_moments *moments, int sample, int scale,
+                       s21_decimal *result);
+int s21_moments_covariance(const s21_moments *moments, int sample, int scale,
+                           s21_decimal *result);
+
+// Нарастающая сумма out[i] = in[0] + ... + in[i] (prefix.c). Суммы точные
+// и округляются только на выходе, поэтому out[i] не зависит ни от порядка
+// сложения, ни от политики. Параллельно считается в два прохода: суммы
+// блоков, затем выходы блоков от их смещений. Если сумма не помещается в
+// decimal, out[i] = 0 и codes[i] - код переполнения, следующие элементы
+// считаются дальше. Элемент с недопустимым scale в сумму не входит
+// (CodeInvalidData). codes может быть NULL; возвращается код первого
+// неудачного элемента
+int s21_prefix_sum(const s21_decimal *in, s21_decimal *out, size_t n,
+                   int *codes, const s21_exec_policy *policy);
+
+// Порядковые статистики без полной сортировки (select.c). Значения
+// сравниваются по величине (1.0 и 1.00 равны), из равных раньше идет
+// элемент с меньшим индексом, поэтому ответ однозначен и не зависит от
+// политики. Элемент с недопустимым scale дает CodeInvalidData.
+// s21_nth_element - k-й по возрастанию (с 0) элемент массива, как есть
+int s21_nth_element(const s21_decimal *values, size_t n, size_t k,
+                    s21_decimal *result, const s21_exec_policy *policy);
+// Процентиль percent (0..100) с линейной интерполяцией между соседними
+// порядковыми статистиками ранга percent / 100 * (n - 1); интерполяция
+// точная, округление (банковское) одно
+int s21_percentile(const s21_decimal *values, size_t n, s21_decimal percent,
+                   s21_decimal *result, const s21_exec_policy *policy);
+// k наибольших по убыванию (из равных первым идет более ранний) и их
+// индексы; out и indices могут быть NULL
+int s21_top_k(const s21_decimal *values, size_t n, size_t k,
+              s21_decimal *out, size_t *indices,
+              const s21_exec_policy *policy);
+
+// Агрегация по группам (group.c): сумма, количество, min, max и среднее
+// значений по ключу. Ключи int64 или decimal; равные decimal-ключи в
+// разной записи (1.5 и 1.50) попадают в одну группу, ключ группы хранится
+// без лишних нулей дробной части. Суммы точные и округляются только при
+// чтении. Параллельная политика сначала раскладывает строки по разделам
+// (по старшим битам хеша ключа) так, чтобы таблица раздела помещалась в
+// L2, и считает разделы независимо; результат совпадает с
+// последовательным побитно
+typedef struct {
+  s21_decimal key;
+  size_t count;
+  size_t first;  // номер первой строки группы
+  // min и max - из равных первое по порядку строк значение как есть
+  s21_decimal min;
+  s21_decimal max;
+  // Точная сумма, внутреннее состояние (читается через s21_group_sum):
+  // значения со scale первого значения группы - в sum_bits (128 бит в
+  // дополнительном коде) со scale sum_scale, остальные - в rest (NULL,
+  // пока их нет)
+  unsigned int sum_bits[4];
+  int sum_scale;
+  s21_wide *rest;
+} s21_group;
+
+typedef struct {
+  s21_group *groups;  // в порядке первого появления ключа
+  size_t count;
+} s21_group_table;
+
+// table заполняется заново (прежнее содержимое нужно освободить) и
+// освобождается s21_group_table_free. Строки с недопустимым scale ключа
+// или значения пропускаются, тогда возвращается CodeInvalidData
+int s21_group_by_i64(const int64_t *keys, const s21_decimal *values,
+                     size_t n, s21_group_table *table,
+                     const s21_exec_policy *policy);
+int s21_group_by_decimal(const s21_decimal *keys, const s21_decimal *values,
+                         size_t n, s21_group_table *table,
+                         const s21_exec_policy *policy);
+void s21_group_table_free(s21_group_table *table);
+// Сумма с банковским округлением; среднее - одно деление до scale (0..28),
+// scale меньше, если среднее с ним не помещается в decimal
+int s21_group_sum(const s21_group *group, s21_decimal *result);
+int s21_group_avg(const s21_group *group, int scale, s21_decimal *result);
+
+// Генератор синтетической нагрузки (workload.c). Поток значений
+// определяется seed (и libm, через которую считаются логнормальные величины)
+typedef enum {
+  S21_WORKLOAD_PRICE,     // логнормальные цены, scale по шагу цены
+  S21_WORKLOAD_QUANTITY,  // целые количества, часто кратные лоту
+  S21_WORKLOAD_FX_RATE,   // курсы валют с 5-8 знаками после запятой
+  S21_WORKLOAD_NOTIONAL,  // полноразрядные суммы (96-битные мантиссы)
+  S21_WORKLOAD_PNL,       // прибыль и убыток обоих знаков, scale 2
+  S21_WORKLOAD_MIXED,     // смесь всех видов в пропорциях реального потока
+} s21_workload_kind;
+
+typedef struct {
+  uint64_t state;
+} s21_workload;
+
+// Операции трассы: все публичные функции, через которые ее можно прогнать
+typedef enum {
+  S21_OP_ADD,
+  S21_OP_SUB,
+  S21_OP_MUL,
+  S21_OP_DIV,
+  S21_OP_IS_LESS,
+  S21_OP_IS_LESS_OR_EQUAL,
+  S21_OP_IS_GREATER,
+  S21_OP_IS_GREATER_OR_EQUAL,
+  S21_OP_IS_EQUAL,
+  S21_OP_IS_NOT_EQUAL,
+  S21_OP_FLOOR,
+  S21_OP_ROUND,
+  S21_OP_TRUNCATE,
+  S21_OP_NEGATE,
+  S21_OP_CEIL,
+  S21_OP_TO_INT,
+  S21_OP_TO_FLOAT,
+  S21_OP_RESCALE,  // приведение a к scale 2 (банковское округление)
+  S21_OP_COUNT,
+} s21_trace_op_code;
+
+typedef struct {
+  s21_trace_op_code op;
+  s21_decimal a;
+  s21_decimal b;  // для унарных операций не используется
+} s21_trace_op;
+
+void s21_workload_init(s21_workload *workload, uint64_t seed);
+s21_decimal s21_workload_next(s21_workload *workload, s21_workload_kind kind);
+void s21_workload_fill(s21_workload *workload, s21_workload_kind kind,
+                       s21_decimal *out, size_t n);
+void s21_workload_trace(s21_workload *workload, s21_trace_op *ops, size_t n);
+// Прогон трассы через API. results и codes могут быть NULL; результат
+// сравнения и перевода в int записывается как целое decimal. Возвращает
+// первый ненулевой код или CodeOK
+int s21_trace_replay(const s21_trace_op *ops, size_t n, s21_decimal *results,
+                     int *codes);
+const char *s21_trace_op_name(s21_trace_op_code op);
+// Текстовый формат трассы: строка на операцию, "имя a0 a1 a2 a3 b0 b1 b2 b3"
+// (слова в hex), строки с # - комментарии
+int s21_trace_write(FILE *out, const s21_trace_op *ops, size_t n);
+int s21_trace_read(FILE *in, s21_trace_op *ops, size_t capacity,
+                   size_t *count);
+
+// Счетчики горячих путей (stats.c). Считаются только в сборке с
+// -DS21_STATS (make stats): у каждого потока свои счетчики без блокировок,
+// снимок складывает их по всем потокам. В обычной сборке макросы
+// S21_STAT_* пустые, а снимок возвращает нули с enabled = 0
+typedef enum {
+  S21_STAT_ALIGN_SAME_SCALE,       // align_scale: scale уже равны
+  S21_STAT_ALIGN_LOSSY,            // align_scale: выравнивание с округлением
+  S21_STAT_ALIGN_LOSSY_DIGITS,     // отброшенные при этом цифры
+  S21_STAT_MUL_NORMALIZE,          // вызовы mul_normalize
+  S21_STAT_MUL_NORMALIZE_STEPS,    // итерации (деления на 10) в нем
+  S21_STAT_DIV_FRACTIONAL,         // вызовы div_calc_fractional
+  S21_STAT_DIV_FRACTIONAL_DIGITS,  // цифры дробной части в нем
+  S21_STAT_OVERFLOW,               // возвраты CodeBigNumber/SmallNumber
+  S21_STAT_FAST_ADD_I64,           // add_integer без общего s21_add
+  S21_STAT_FAST_DIV_I64,           // s21_div_i64 с делителем в одно слово
+  S21_STAT_FAST_QUANTIZE_64,       // quantize_one с 64-битной мантиссой
+  S21_STAT_FAST_ATOMIC_ADD,        // s21_atomic_add без s21_add
+  S21_STAT_ATOMIC_RETRIES,         // повторы CAS в s21_atomic_add
+  S21_STAT_COUNT,
+} s21_stat_counter;
+
+typedef struct {
+  uint64_t counters[S21_STAT_COUNT];
+  int enabled;  // 1, если библиотека собрана с S21_STATS
+} s21_stats;
+
+void s21_stats_snapshot(s21_stats *out);
+void s21_stats_reset(void);
+const char *s21_stats_name(s21_stat_counter counter);
+
+#ifdef S21_STATS
+void s21_stats_add(s21_stat_counter counter, uint64_t n);
+#define S21_STAT_ADD(counter, n) s21_stats_add((counter), (uint64_t)(n))
+#else
+#define S21_STAT_ADD(counter, n) ((void)0)
+#endif
+#define S21_STAT_INC(counter) S21_STAT_ADD(counter, 1)
+
+// Гистограммы задержек публичных функций (latency.c). Замеры включаются
+// сборкой с -DS21_LATENCY (make latency): замеряется каждый rate-й вызов
+// в потоке, время в тактах rdtsc (или в наносекундах вне x86) пишется в
+// логарифмически-линейную гистограмму потока: 16 корзин на каждую степень
+// двойки, относительная ошибка не больше 1/16
+typedef enum {
+  S21_LAT_ADD,
+  S21_LAT_SUB,
+  S21_LAT_MUL,
+  S21_LAT_DIV,
+  S21_LAT_IS_LESS,
+  S21_LAT_IS_LESS_OR_EQUAL,
+  S21_LAT_IS_GREATER,
+  S21_LAT_IS_GREATER_OR_EQUAL,
+  S21_LAT_IS_EQUAL,
+  S21_LAT_IS_NOT_EQUAL,
+  S21_LAT_FROM_INT,
+  S21_LAT_FROM_FLOAT,
+  S21_LAT_TO_INT,
+  S21_LAT_TO_FLOAT,
+  S21_LAT_FLOOR,
+  S21_LAT_ROUND,
+  S21_LAT_TRUNCATE,
+  S21_LAT_NEGATE,
+  S21_LAT_CEIL,
+  S21_LAT_COUNT,
+} s21_latency_op;
+
+typedef enum {
+  S21_LATENCY_TEXT,
+  S21_LATENCY_JSON,
+} s21_latency_format;
+
+// Значения до 2^48 единиц, большие попадают в последнюю корзину
+#define S21_LATENCY_SUB_BITS 4
+#define S21_LATENCY_BUCKETS \
+  ((48 - S21_LATENCY_SUB_BITS + 1) << S21_LATENCY_SUB_BITS)
+// Замеряется каждый S21_LATENCY_RATE-й вызов (до s21_latency_set_rate)
+#ifndef S21_LATENCY_RATE
+#define S21_LATENCY_RATE 64
+#endif
+
+typedef struct {
+  uint64_t counts[S21_LATENCY_BUCKETS];
+  uint64_t total;  // число замеров
+  uint64_t sum;    // сумма значений (для среднего)
+  uint64_t min;
+  uint64_t max;
+} s21_latency_histogram;
+
+// 1 в каждые rate вызовов, 0 - замеры выключены
+void s21_latency_set_rate(unsigned int rate);
+void s21_latency_reset(void);
+// Сумма гистограмм всех потоков для операции op
+int s21_latency_merge(s21_latency_op op, s21_latency_histogram *out);
+// Значение перцентиля p (0..100): верхняя граница корзины, не больше max
+uint64_t s21_latency_percentile(const s21_latency_histogram *histogram,
+                                double p);
+// Сводка по всем операциям с замерами: число, среднее и перцентили
+int s21_latency_dump(FILE *out, s21_latency_format format);
+const char *s21_latency_op_name(s21_latency_op op);
+// "cycles" или "ns"; пустая строка, если библиотека собрана без замеров
+const char *s21_latency_unit(void);
+
+#ifdef S21_LATENCY
+typedef struct {
+  s21_latency_op op;
+  uint64_t start;  // 0 - вызов не замеряется
+} s21_latency_probe;
+s21_latency_probe s21_latency_begin(s21_latency_op op);
+void s21_latency_end(s21_latency_probe *probe);
+// Замер до выхода из функции (в том числе по раннему return)
+#define S21_TIMED(op)                                                     \
+  s21_latency_probe s21_probe __attribute__((cleanup(s21_latency_end))) = \
+      s21_latency_begin(op)
+#else
+#define S21_TIMED(op) ((void)0)
+#endif
+
+#if defined(__GNUC__)
+#pragma GCC visibility pop
+#endif
 
 // Вспомогательные функции
 s21_decimal decimal_zero();
+s21_decimal decimal_pow10(int power);
 int is_zero(s21_decimal value);
 int get_bit(s21_decimal number, int bit);
 void set_bit(s21_decimal *number, int bit, int sign);
@@ -85,4 +648,55 @@ int bit_equality(s21_decimal num1, s21_decimal num2, int result);
 int s21_is_equal_for_zero(s21_decimal num1, s21_decimal num2);
 void s21_bank_rounding(s21_decimal *val, int remainder);
 
+// Операции над многословными числами (младшее слово первым)
+unsigned int limbs_div_u32(unsigned int *limbs, int count,
+                           unsigned int divisor);
+unsigned int limbs_mul_u32(unsigned int *limbs, int count,
+                           unsigned int factor);
+int limbs_increment(unsigned int *limbs, int count);
+int limbs_div_pow10(unsigned int *limbs, int count, int power, int *sticky);
+int limbs_mul_pow10(unsigned int *limbs, int count, int power);
+int rounding_increment_by_half(int half_cmp, int inexact, int odd, int sign,
+                               s21_rounding_mode mode);
+int rounding_increment(int guard, int sticky, int odd, int sign,
+                       s21_rounding_mode mode);
+
+// Широкие числа
+s21_wide wide_zero();
+void wide_from_decimal(s21_decimal value, s21_wide *result);
+void wide_from_i64(int64_t value, s21_wide *result);
+int wide_to_decimal(const s21_wide *value, s21_rounding_mode mode,
+                    s21_decimal *result);
+int wide_to_decimal_scale(const s21_wide *value, int max_scale,
+                          s21_rounding_mode mode, s21_decimal *result);
+int wide_is_zero(const s21_wide *value);
+int wide_bit_length(const s21_wide *value);
+int wide_digit_count(const s21_wide *value);
+int wide_upscale(s21_wide *value, int scale);
+int wide_round_scale(s21_wide *value, int scale, s21_rounding_mode mode);
+void wide_round_digits(s21_wide *value, int digits, s21_rounding_mode mode);
+int wide_add(s21_wide *acc, const s21_wide *value);
+int wide_sub(s21_wide *acc, const s21_wide *value);
+int wide_add_decimal(s21_wide *acc, s21_decimal value);
+int wide_mul(const s21_wide *a, const s21_wide *b, s21_wide *result);
+int wide_div(const s21_wide *dividend, const s21_wide *divisor, int scale,
+             s21_rounding_mode mode, s21_wide *result);
+int wide_div_to_decimal(const s21_wide *dividend, const s21_wide *divisor,
+                        int scale, s21_rounding_mode mode,
+                        s21_decimal *result);
+void wide_isqrt(const s21_wide *number, s21_wide *root);
+
+// Поэлементные пакеты на s21_exec_for (pool.c). element считает элемент
+// index и возвращает его код; batch_apply пишет коды в codes (если не NULL)
+// и возвращает код первой по индексу ошибки или CodeOK
+typedef int (*batch_element)(const void *context, size_t index);
+
+int batch_apply(const s21_exec_policy *policy, size_t n, size_t cost_ns,
+                batch_element element, const void *context, int *codes);
+// Первая по индексу ошибка: индекс и код упакованы в одно слово (начальное
+// значение BATCH_NO_ERROR), минимум обновляется CAS из любого потока
+#define BATCH_NO_ERROR UINT64_MAX
+void batch_note_error(uint64_t *first, size_t index, int code);
+int batch_error_code(uint64_t first);
+
 #endif
@@ -0,0 +1,74 @@
+#ifndef S21_DECIMAL_INLINE_H
+#define S21_DECIMAL_INLINE_H
+
+#include "s21_decimal.h"
+
+// Встраиваемые версии битовых помощников. После подключения этого заголовка
+// вызовы get_bit, get_scale и других перенаправляются макросами на
+// static inline функции и могут встраиваться в циклы вызывающего кода.
+// Внешние функции с теми же именами остаются в библиотеке (s21_decimal.c)
+// ради ABI; взять их адрес или вызвать явно можно через (get_bit)(...)
+
+static inline int is_zero_inline(s21_decimal value) {
+  return (value.bits[0] == 0 && value.bits[1] == 0 && value.bits[2] == 0);
+}
+
+static inline int get_bit_inline(s21_decimal number, int bit) {
+  return (number.bits[bit / 32] >> (bit % 32)) & 1;
+}
+
+static inline void set_bit_inline(s21_decimal *number, int bit, int sign) {
+  if (sign == 0) {
+    number->bits[bit / 32] &= ~(1u << (bit % 32));
+  } else {
+    number->bits[bit / 32] |= (1u << (bit % 32));
+  }
+}
+
+static inline int get_sign_inline(s21_decimal number) {
+  return (number.bits[3] >> 31) & 1;
+}
+
+static inline void set_sign_inline(s21_decimal *number, int sign) {
+  if (number != NULL) {
+    if (sign == 1) {
+      number->bits[3] |= (1u << 31);
+    } else {
+      number->bits[3] &= ~(1u << 31);
+    }
+  }
+}
+
+static inline int get_scale_inline(s21_decimal number) {
+  return (number.bits[3] >> 16) & 0xFF;
+}
+
+static inline void set_scale_inline(s21_decimal *number, int scale) {
+  if (number != NULL && scale >= 0 && scale <= 28) {
+    number->bits[3] &= ~(0xFFu << 16);
+    number->bits[3] |= ((unsigned int)scale << 16);
+  }
+}
+
+// Сравнение мантисс без учета знака и scale: -1, 0 или 1
+static inline int compare_magnitude_inline(s21_decimal value_1,
+                                           s21_decimal value_2) {
+  int result = 0;
+  for (int i = 2; i >= 0 && result == 0; i--) {
+    result = (value_1.bits[i] > value_2.bits[i]) -
+             (value_1.bits[i] < value_2.bits[i]);
+  }
+  return result;
+}
+
+#define is_zero(value) is_zero_inline(value)
+#define get_bit(number, bit) get_bit_inline(number, bit)
+#define set_bit(number, bit, sign) set_bit_inline(number, bit, sign)
+#define get_sign(number) get_sign_inline(number)
+#define set_sign(number, sign) set_sign_inline(number, sign)
+#define get_scale(number) get_scale_inline(number)
+#define set_scale(number, scale) set_scale_inline(number, scale)
+#define compare_magnitude(value_1, value_2) \
+  compare_magnitude_inline(value_1, value_2)
+
+#endif
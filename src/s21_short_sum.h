@@ -0,0 +1,45 @@
+#ifndef S21_SHORT_SUM_H
+#define S21_SHORT_SUM_H
+
+#include "s21_decimal_inline.h"
+
+// Внутренний заголовок библиотеки (prefix.c, group.c), в API не входит.
+// Короткая точная сумма - 128 бит в дополнительном коде на четырех словах;
+// scale у всех слагаемых общий и хранится отдельно. Знак учитывается
+// маской, без ветвлений, которые на суммах обоих знаков предсказываются
+// плохо. Без переполнения помещается не меньше 2^31 слагаемых по 96 бит
+
+// sum += value
+static inline void short_add(unsigned int *sum, s21_decimal value) {
+  unsigned int mask = 0u - (unsigned int)get_sign_inline(value);
+  unsigned long long carry = mask & 1;
+  for (int i = 0; i < 3; i++) {
+    carry += (unsigned long long)sum[i] + (value.bits[i] ^ mask);
+    sum[i] = (unsigned int)carry;
+    carry >>= 32;
+  }
+  sum[3] += mask + (unsigned int)carry;
+}
+
+// Модуль суммы, возвращает знак
+static inline int short_magnitude(const unsigned int *sum,
+                                  unsigned int *magnitude) {
+  unsigned int negative = sum[3] >> 31;
+  unsigned int mask = 0u - negative;
+  unsigned long long carry = negative;
+  for (int i = 0; i < 4; i++) {
+    carry += sum[i] ^ mask;
+    magnitude[i] = (unsigned int)carry;
+    carry >>= 32;
+  }
+  return (int)negative;
+}
+
+static inline void short_to_wide(const unsigned int *sum, int scale,
+                                 s21_wide *result) {
+  *result = wide_zero();
+  result->sign = short_magnitude(sum, result->bits);
+  result->scale = scale;
+}
+
+#endif
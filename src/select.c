@@ -0,0 +1,467 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "s21_decimal_inline.h"
+
+// Отрезки не длиннее этого досортировываются вставками
+#define INSERTION_LIMIT 16
+// Элементов в блоке параллельного подсчета и top-K
+#define SELECT_BLOCK 65536
+// Выборка для границ кандидатов и запас рангов вокруг k в ней
+#define SAMPLE_SIZE 4096
+#define SAMPLE_SLACK 64
+
+// Ключ, сохраняющий порядок: модуль, приведенный к scale 28 (до 190 бит),
+// у положительных с единицей в старшем бите, у отрицательных - инверсия
+// без старшего бита. Равные значения с разной записью (1.0 и 1.00) дают
+// равные ключи, порядок среди них задает индекс: порядок полный, и ответ
+// не зависит ни от алгоритма, ни от числа потоков
+typedef struct {
+  unsigned long long words[3];  // words[0] - старшее
+  size_t index;
+} select_key;
+
+static select_key encode_key(s21_decimal value, size_t index) {
+  s21_decimal power = decimal_pow10(28 - get_scale(value));
+  unsigned int limbs[6] = {0};
+  for (int j = 0; j < 3; j++) {
+    unsigned long long carry = 0;
+    for (int k = 0; k < 3; k++) {
+      carry += (unsigned long long)value.bits[j] * power.bits[k] + limbs[j + k];
+      limbs[j + k] = (unsigned int)carry;
+      carry >>= 32;
+    }
+    limbs[j + 3] = (unsigned int)carry;
+  }
+  select_key key;
+  key.index = index;
+  for (int i = 0; i < 3; i++) {
+    key.words[2 - i] =
+        ((unsigned long long)limbs[2 * i + 1] << 32) | limbs[2 * i];
+  }
+  if (get_sign(value) && !is_zero(value)) {
+    for (int i = 0; i < 3; i++) key.words[i] = ~key.words[i];
+    key.words[0] &= ~(1ULL << 63);
+  } else {
+    key.words[0] |= 1ULL << 63;
+  }
+  return key;
+}
+
+static int key_less(const select_key *a, const select_key *b) {
+  int order = 0;
+  for (int i = 0; i < 3 && order == 0; i++) {
+    if (a->words[i] != b->words[i]) {
+      order = (a->words[i] < b->words[i]) ? -1 : 1;
+    }
+  }
+  return order < 0 || (order == 0 && a->index < b->index);
+}
+
+static void swap_keys(select_key *a, select_key *b) {
+  select_key tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+// a ближе к корню кучи, чем b: в корне min-кучи наименьший ключ, в корне
+// max-кучи - наибольший
+static int heap_before(const select_key *a, const select_key *b,
+                       int min_heap) {
+  return min_heap ? key_less(a, b) : key_less(b, a);
+}
+
+static void heap_sift(select_key *heap, size_t n, size_t root, int min_heap) {
+  int done = 0;
+  while (!done && 2 * root + 1 < n) {
+    size_t child = 2 * root + 1;
+    if (child + 1 < n &&
+        heap_before(&heap[child + 1], &heap[child], min_heap)) {
+      child++;
+    }
+    if (heap_before(&heap[child], &heap[root], min_heap)) {
+      swap_keys(&heap[root], &heap[child]);
+      root = child;
+    } else {
+      done = 1;
+    }
+  }
+}
+
+static void heap_build(select_key *heap, size_t n, int min_heap) {
+  for (size_t i = n / 2; i > 0; i--) heap_sift(heap, n, i - 1, min_heap);
+}
+
+// Сортировка кучей: по возрастанию из max-кучи, по убыванию из min-кучи
+static void heap_sort(select_key *keys, size_t n, int descending) {
+  heap_build(keys, n, descending);
+  for (size_t end = n; end > 1; end--) {
+    swap_keys(&keys[0], &keys[end - 1]);
+    heap_sift(keys, end - 1, 0, descending);
+  }
+}
+
+static void insertion_sort(select_key *keys, size_t n) {
+  for (size_t i = 1; i < n; i++) {
+    select_key key = keys[i];
+    size_t j = i;
+    for (; j > 0 && key_less(&key, &keys[j - 1]); j--) keys[j] = keys[j - 1];
+    keys[j] = key;
+  }
+}
+
+// Introselect: quickselect с медианой трех, а если глубина превысила
+// 2 log2(n) (неудачные опорные), оставшийся отрезок сортируется кучей.
+// После вызова keys[k] - k-й по порядку ключ
+static void introselect(select_key *keys, size_t n, size_t k) {
+  size_t left = 0;
+  size_t right = n;
+  int depth = 0;
+  for (size_t m = n; m > 1; m >>= 1) depth += 2;
+  while (right - left > INSERTION_LIMIT && depth > 0) {
+    depth--;
+    size_t middle = left + (right - left) / 2;
+    if (key_less(&keys[middle], &keys[left])) {
+      swap_keys(&keys[middle], &keys[left]);
+    }
+    if (key_less(&keys[right - 1], &keys[left])) {
+      swap_keys(&keys[right - 1], &keys[left]);
+    }
+    if (key_less(&keys[right - 1], &keys[middle])) {
+      swap_keys(&keys[right - 1], &keys[middle]);
+    }
+    swap_keys(&keys[middle], &keys[right - 1]);
+    select_key pivot = keys[right - 1];
+    size_t store = left;
+    for (size_t i = left; i < right - 1; i++) {
+      if (key_less(&keys[i], &pivot)) swap_keys(&keys[i], &keys[store++]);
+    }
+    swap_keys(&keys[store], &keys[right - 1]);
+    if (k < store) {
+      right = store;
+    } else if (k > store) {
+      left = store + 1;
+    } else {
+      left = store;
+      right = store + 1;
+    }
+  }
+  if (right - left > INSERTION_LIMIT) {
+    heap_sort(keys + left, right - left, 0);
+  } else {
+    insertion_sort(keys + left, right - left);
+  }
+}
+
+typedef struct {
+  const s21_decimal *values;
+  select_key *keys;
+  size_t n;
+  int invalid;
+  // Кандидаты на ранг k: ключи в [low, high]
+  select_key low;
+  select_key high;
+  int has_low;
+  int has_high;
+  size_t *below;   // по блокам: ключей меньше low
+  size_t *inside;  // по блокам: кандидатов
+  select_key *candidates;
+} select_context;
+
+static void encode_range(void *argument, size_t begin, size_t end) {
+  select_context *context = argument;
+  for (size_t i = begin; i < end; i++) {
+    if (get_scale(context->values[i]) > 28) {
+      __atomic_store_n(&context->invalid, 1, __ATOMIC_RELAXED);
+    }
+    context->keys[i] = encode_key(context->values[i], i);
+  }
+}
+
+static size_t block_count(size_t n) {
+  return (n + SELECT_BLOCK - 1) / SELECT_BLOCK;
+}
+
+// 0 - ключ ниже low, 1 - кандидат, 2 - выше high
+static int candidate_side(const select_context *context,
+                          const select_key *key) {
+  int side = 1;
+  if (context->has_low && key_less(key, &context->low)) {
+    side = 0;
+  } else if (context->has_high && key_less(&context->high, key)) {
+    side = 2;
+  }
+  return side;
+}
+
+static void count_blocks(void *argument, size_t begin, size_t end) {
+  select_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t last = (block + 1) * SELECT_BLOCK;
+    if (last > context->n) last = context->n;
+    size_t counts[3] = {0};
+    for (size_t i = block * SELECT_BLOCK; i < last; i++) {
+      counts[candidate_side(context, &context->keys[i])]++;
+    }
+    context->below[block] = counts[0];
+    context->inside[block] = counts[1];
+  }
+}
+
+// inside[block] к этому моменту - смещение блока среди кандидатов
+static void gather_blocks(void *argument, size_t begin, size_t end) {
+  select_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t last = (block + 1) * SELECT_BLOCK;
+    if (last > context->n) last = context->n;
+    size_t position = context->inside[block];
+    for (size_t i = block * SELECT_BLOCK; i < last; i++) {
+      if (candidate_side(context, &context->keys[i]) == 1) {
+        context->candidates[position++] = context->keys[i];
+      }
+    }
+  }
+}
+
+// Параллельная выборка: по выборке из SAMPLE_SIZE ключей берутся границы
+// вокруг ожидаемого места k, потоки считают ключи ниже границ и внутри, и
+// introselect идет только по кандидатам. Если k вне кандидатов (выборка
+// неудачна), возвращается 0 и выбор идет по всему массиву
+static int select_by_sample(select_context *context, size_t k,
+                            const s21_exec_policy *policy,
+                            select_key *result) {
+  select_key *sample = malloc(sizeof(select_key) * SAMPLE_SIZE);
+  size_t blocks = block_count(context->n);
+  context->below = malloc(sizeof(size_t) * blocks);
+  context->inside = malloc(sizeof(size_t) * blocks);
+  context->candidates = NULL;
+  int found = 0;
+  if (sample && context->below && context->inside) {
+    // Выборка равномерно покрывает весь массив; rank < SAMPLE_SIZE, так
+    // как k < n, и при n, не кратном SAMPLE_SIZE
+    for (size_t i = 0; i < SAMPLE_SIZE; i++) {
+      sample[i] = context->keys[i * context->n / SAMPLE_SIZE];
+    }
+    heap_sort(sample, SAMPLE_SIZE, 0);
+    size_t rank = k * SAMPLE_SIZE / context->n;
+    context->has_low = rank >= SAMPLE_SLACK;
+    context->has_high = rank + SAMPLE_SLACK < SAMPLE_SIZE;
+    if (context->has_low) context->low = sample[rank - SAMPLE_SLACK];
+    if (context->has_high) context->high = sample[rank + SAMPLE_SLACK];
+    s21_exec_for(policy, blocks, 1, count_blocks, context);
+    size_t below = 0;
+    size_t inside = 0;
+    for (size_t block = 0; block < blocks; block++) {
+      below += context->below[block];
+      size_t count = context->inside[block];
+      context->inside[block] = inside;
+      inside += count;
+    }
+    if (k >= below && k - below < inside) {
+      context->candidates = malloc(sizeof(select_key) * inside);
+    }
+    if (context->candidates) {
+      s21_exec_for(policy, blocks, 1, gather_blocks, context);
+      introselect(context->candidates, inside, k - below);
+      *result = context->candidates[k - below];
+      found = 1;
+    }
+  }
+  free(sample);
+  free(context->below);
+  free(context->inside);
+  free(context->candidates);
+  return found;
+}
+
+// Ключ ранга k (keys уже заполнены)
+static select_key select_rank(select_context *context, size_t k,
+                              const s21_exec_policy *policy) {
+  select_key result;
+  int parallel = policy && policy->mode != S21_EXEC_SEQUENTIAL &&
+                 context->n >= 4 * SAMPLE_SIZE;
+  if (!parallel || !select_by_sample(context, k, policy, &result)) {
+    introselect(context->keys, context->n, k);
+    result = context->keys[k];
+  }
+  return result;
+}
+
+static int select_prepare(select_context *context, const s21_decimal *values,
+                          size_t n, const s21_exec_policy *policy) {
+  context->values = values;
+  context->n = n;
+  context->invalid = 0;
+  context->keys = malloc(sizeof(select_key) * n);
+  int status = context->keys ? CodeOK : CodeInvalidData;
+  if (status == CodeOK) {
+    status = s21_exec_for(policy, n, s21_exec_grain(S21_COST_QUANTIZE),
+                          encode_range, context);
+  }
+  if (status == CodeOK && context->invalid) status = CodeInvalidData;
+  return status;
+}
+
+int s21_nth_element(const s21_decimal *values, size_t n, size_t k,
+                    s21_decimal *result, const s21_exec_policy *policy) {
+  if (!values || !result || k >= n) return CodeInvalidData;
+  select_context context;
+  int status = select_prepare(&context, values, n, policy);
+  if (status == CodeOK) {
+    *result = values[select_rank(&context, k, policy).index];
+  }
+  free(context.keys);
+  return status;
+}
+
+// Ранг percent / 100 * (n - 1): целая часть и дробная доля
+static int percentile_rank(s21_decimal percent, size_t n, size_t *whole,
+                           s21_wide *fraction) {
+  s21_wide share;
+  s21_wide count;
+  s21_wide rank;
+  s21_wide integer;
+  wide_from_decimal(percent, &share);
+  wide_from_i64((int64_t)(n - 1), &count);
+  int status = wide_mul(&share, &count, &rank);
+  // Деление на 100 - сдвиг scale
+  rank.scale += 2;
+  integer = rank;
+  if (status == CodeOK) {
+    status = wide_round_scale(&integer, 0, S21_ROUND_TRUNCATE);
+  }
+  *fraction = rank;
+  if (status == CodeOK) status = wide_sub(fraction, &integer);
+  *whole = ((size_t)integer.bits[1] << 32) | integer.bits[0];
+  return status;
+}
+
+int s21_percentile(const s21_decimal *values, size_t n, s21_decimal percent,
+                   s21_decimal *result, const s21_exec_policy *policy) {
+  s21_decimal hundred = {{100, 0, 0, 0}};
+  if (!values || !result || n == 0 || get_scale(percent) > 28 ||
+      s21_is_less(percent, decimal_zero()) ||
+      s21_is_greater(percent, hundred)) {
+    return CodeInvalidData;
+  }
+  size_t whole = 0;
+  s21_wide fraction;
+  select_context context;
+  context.keys = NULL;
+  int status = percentile_rank(percent, n, &whole, &fraction);
+  if (status == CodeOK) status = select_prepare(&context, values, n, policy);
+  if (status == CodeOK) {
+    s21_decimal lower = values[select_rank(&context, whole, policy).index];
+    *result = lower;
+    if (!wide_is_zero(&fraction)) {
+      // lower + fraction * (upper - lower) точно, округление одно
+      s21_decimal upper =
+          values[select_rank(&context, whole + 1, policy).index];
+      s21_wide low;
+      s21_wide gap;
+      s21_wide step;
+      wide_from_decimal(lower, &low);
+      wide_from_decimal(upper, &gap);
+      status = wide_sub(&gap, &low);
+      if (status == CodeOK) status = wide_mul(&gap, &fraction, &step);
+      if (status == CodeOK) status = wide_add(&low, &step);
+      if (status == CodeOK) {
+        status = wide_to_decimal(&low, S21_ROUND_HALF_EVEN, result);
+      }
+    }
+  }
+  free(context.keys);
+  return status;
+}
+
+// Предложение ключа куче k наибольших (min-куча размера size <= k)
+static void heap_offer(select_key *heap, size_t *size, size_t k,
+                       const select_key *key) {
+  if (*size < k) {
+    heap[(*size)++] = *key;
+    if (*size == k) heap_build(heap, k, 1);
+  } else if (key_less(&heap[0], key)) {
+    heap[0] = *key;
+    heap_sift(heap, k, 0, 1);
+  }
+}
+
+// Ключ для top-K: индекс инвертирован, и из равных значений выше ранг у
+// более раннего элемента
+static select_key top_key(const s21_decimal *values, size_t i) {
+  return encode_key(values[i], SIZE_MAX - i);
+}
+
+typedef struct {
+  const s21_decimal *values;
+  size_t n;
+  size_t k;
+  select_key *heaps;  // по k ключей на блок
+  size_t *sizes;
+  int invalid;
+} top_context;
+
+static void top_blocks(void *argument, size_t begin, size_t end) {
+  top_context *context = argument;
+  for (size_t block = begin; block < end; block++) {
+    size_t last = (block + 1) * SELECT_BLOCK;
+    if (last > context->n) last = context->n;
+    select_key *heap = context->heaps + block * context->k;
+    size_t size = 0;
+    for (size_t i = block * SELECT_BLOCK; i < last; i++) {
+      if (get_scale(context->values[i]) > 28) {
+        __atomic_store_n(&context->invalid, 1, __ATOMIC_RELAXED);
+      }
+      select_key key = top_key(context->values, i);
+      heap_offer(heap, &size, context->k, &key);
+    }
+    context->sizes[block] = size;
+  }
+}
+
+int s21_top_k(const s21_decimal *values, size_t n, size_t k,
+              s21_decimal *out, size_t *indices,
+              const s21_exec_policy *policy) {
+  if (!values || k > n) return CodeInvalidData;
+  // Каждый блок набирает свои k наибольших, затем кучи блоков сливаются.
+  // При большом k кучи блоков не меньше самого массива, и блок один
+  size_t blocks = block_count(n);
+  int parallel = policy && policy->mode != S21_EXEC_SEQUENTIAL &&
+                 blocks > 1 && k > 0 && k <= SELECT_BLOCK / 4;
+  top_context context = {values, n, k, NULL, NULL, 0};
+  select_key *heap = malloc(sizeof(select_key) * (k + 1));
+  int status = heap ? CodeOK : CodeInvalidData;
+  size_t size = 0;
+  if (status == CodeOK && parallel) {
+    context.heaps = malloc(sizeof(select_key) * k * blocks);
+    context.sizes = malloc(sizeof(size_t) * blocks);
+    if (!context.heaps || !context.sizes) status = CodeInvalidData;
+    if (status == CodeOK) {
+      status = s21_exec_for(policy, blocks, 1, top_blocks, &context);
+    }
+    for (size_t block = 0; block < blocks && status == CodeOK; block++) {
+      for (size_t i = 0; i < context.sizes[block]; i++) {
+        heap_offer(heap, &size, k, &context.heaps[block * k + i]);
+      }
+    }
+  } else if (status == CodeOK && k > 0) {
+    for (size_t i = 0; i < n; i++) {
+      if (get_scale(values[i]) > 28) context.invalid = 1;
+      select_key key = top_key(values, i);
+      heap_offer(heap, &size, k, &key);
+    }
+  }
+  if (status == CodeOK && context.invalid) status = CodeInvalidData;
+  if (status == CodeOK) {
+    heap_sort(heap, k, 1);
+    for (size_t i = 0; i < k; i++) {
+      size_t index = SIZE_MAX - heap[i].index;
+      if (out) out[i] = values[index];
+      if (indices) indices[i] = index;
+    }
+  }
+  free(context.heaps);
+  free(context.sizes);
+  free(heap);
+  return status;
+}
@@ -0,0 +1,74 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "s21_decimal_inline.h"
+
+int s21_sharded_init(s21_sharded_sum *sum, size_t shards) {
+  if (!sum || shards == 0) return CodeInvalidData;
+  // Размер слота кратен кэш-линии благодаря _Alignas, соседние слоты не
+  // делят линию
+  sum->slots = aligned_alloc(S21_CACHE_LINE, sizeof(s21_sharded_slot) * shards);
+  sum->count = sum->slots ? shards : 0;
+  s21_sharded_reset(sum);
+  return sum->slots ? CodeOK : CodeInvalidData;
+}
+
+void s21_sharded_free(s21_sharded_sum *sum) {
+  if (sum) {
+    free(sum->slots);
+    sum->slots = NULL;
+    sum->count = 0;
+  }
+}
+
+void s21_sharded_reset(s21_sharded_sum *sum) {
+  for (size_t i = 0; sum && i < sum->count; i++) {
+    memset(&sum->slots[i], 0, sizeof(s21_sharded_slot));
+    sum->slots[i].value = wide_zero();
+  }
+}
+
+// Запись в слот под счетчиком версий (seqlock с одним писателем): читатель,
+// увидевший нечетную или изменившуюся версию, перечитывает слот. Писателю
+// хватает обычных store и барьера, lock-префикса нет
+int s21_sharded_add(s21_sharded_sum *sum, size_t shard, s21_decimal value) {
+  if (!sum || shard >= sum->count) return CodeInvalidData;
+  s21_sharded_slot *slot = &sum->slots[shard];
+  unsigned int sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->sequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  int status = wide_add_decimal(&slot->value, value);
+  // После ошибки значение слота не определено, ошибку вернет чтение
+  if (status != CodeOK && slot->status == CodeOK) slot->status = status;
+  __atomic_store_n(&slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+  return status;
+}
+
+// Согласованная копия слота
+static int read_slot(const s21_sharded_slot *slot, s21_wide *value) {
+  unsigned int before = 0;
+  unsigned int after = 0;
+  int status = CodeOK;
+  do {
+    before = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    memcpy(value, &slot->value, sizeof(*value));
+    status = slot->status;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+  } while ((before & 1) || before != after);
+  return status;
+}
+
+int s21_sharded_read(const s21_sharded_sum *sum, s21_rounding_mode mode,
+                     s21_decimal *result) {
+  if (!sum || !result || !sum->slots) return CodeInvalidData;
+  s21_wide total = wide_zero();
+  int status = CodeOK;
+  for (size_t i = 0; i < sum->count && status == CodeOK; i++) {
+    s21_wide value;
+    status = read_slot(&sum->slots[i], &value);
+    if (status == CodeOK) status = wide_add(&total, &value);
+  }
+  if (status == CodeOK) status = wide_to_decimal(&total, mode, result);
+  return status;
+}
@@ -0,0 +1,102 @@
+#include <string.h>
+
+#include "s21_decimal.h"
+
+const char *s21_stats_name(s21_stat_counter counter) {
+  static const char *names[S21_STAT_COUNT] = {
+      "align_same_scale",
+      "align_lossy",
+      "align_lossy_digits",
+      "mul_normalize",
+      "mul_normalize_steps",
+      "div_fractional",
+      "div_fractional_digits",
+      "overflow",
+      "fast_add_i64",
+      "fast_div_i64",
+      "fast_quantize_64",
+      "fast_atomic_add",
+      "atomic_retries",
+  };
+  const char *name = "unknown";
+  if ((int)counter >= 0 && counter < S21_STAT_COUNT) name = names[counter];
+  return name;
+}
+
+#ifdef S21_STATS
+
+#include <stdlib.h>
+
+// Счетчики одного потока. Пишет в value только поток-владелец, поэтому
+// увеличение - это обычные load и store без lock-префикса. Сброс не трогает
+// чужие value, а запоминает их в base; снимок возвращает value - base
+typedef struct stats_slot {
+  uint64_t value[S21_STAT_COUNT];
+  uint64_t base[S21_STAT_COUNT];
+  struct stats_slot *next;
+} stats_slot;
+
+// Список слотов всех потоков (элементы только добавляются в голову)
+static stats_slot *slots = NULL;
+static _Thread_local stats_slot *own_slot = NULL;
+
+// Слот текущего потока создается при первом счете. Слоты не освобождаются:
+// счетчики завершившихся потоков остаются в снимке
+static stats_slot *thread_slot(void) {
+  if (!own_slot) {
+    stats_slot *slot = calloc(1, sizeof(stats_slot));
+    if (slot) {
+      slot->next = __atomic_load_n(&slots, __ATOMIC_RELAXED);
+      while (!__atomic_compare_exchange_n(&slots, &slot->next, slot, 1,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED)) {
+      }
+      own_slot = slot;
+    }
+  }
+  return own_slot;
+}
+
+void s21_stats_add(s21_stat_counter counter, uint64_t n) {
+  stats_slot *slot = thread_slot();
+  if (slot) {
+    uint64_t *cell = &slot->value[counter];
+    __atomic_store_n(cell, __atomic_load_n(cell, __ATOMIC_RELAXED) + n,
+                     __ATOMIC_RELAXED);
+  }
+}
+
+void s21_stats_snapshot(s21_stats *out) {
+  if (!out) return;
+  memset(out, 0, sizeof(*out));
+  out->enabled = 1;
+  for (stats_slot *slot = __atomic_load_n(&slots, __ATOMIC_ACQUIRE); slot;
+       slot = slot->next) {
+    for (int i = 0; i < S21_STAT_COUNT; i++) {
+      // base читается первой: value не меньше любого записанного в base
+      uint64_t base = __atomic_load_n(&slot->base[i], __ATOMIC_ACQUIRE);
+      uint64_t value = __atomic_load_n(&slot->value[i], __ATOMIC_RELAXED);
+      if (value > base) out->counters[i] += value - base;
+    }
+  }
+}
+
+void s21_stats_reset(void) {
+  for (stats_slot *slot = __atomic_load_n(&slots, __ATOMIC_ACQUIRE); slot;
+       slot = slot->next) {
+    for (int i = 0; i < S21_STAT_COUNT; i++) {
+      uint64_t value = __atomic_load_n(&slot->value[i], __ATOMIC_RELAXED);
+      __atomic_store_n(&slot->base[i], value, __ATOMIC_RELEASE);
+    }
+  }
+}
+
+#else
+
+void s21_stats_snapshot(s21_stats *out) {
+  if (out) memset(out, 0, sizeof(*out));
+}
+
+void s21_stats_reset(void) {}
+
+#endif
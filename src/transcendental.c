@@ -0,0 +1,365 @@
+#include "s21_decimal_inline.h"
+
+// Абсолютная точность промежуточных значений (знаков после запятой). Все
+// промежуточные величины по модулю меньше 100, поэтому это не меньше 45
+// значащих цифр - с большим запасом для результата из 29 цифр
+#define WORK_SCALE 45
+
+// Константы хранятся как 54 цифры со scale 53 (три части по 18 цифр)
+#define CONSTANT_SCALE 53
+#define CONSTANT_CHUNK 18
+
+// ln(10)
+static const unsigned long long ln10_chunks[3] = {
+    230258509299404568ULL, 401799145468436420ULL, 760110148862877298ULL};
+
+// exp(j / 4) для j = 1..9: опорные точки для exp и ln
+static const unsigned long long exp_quarter_chunks[9][3] = {
+    {128402541668774148ULL, 407342056806243645ULL, 833628086528146309ULL},
+    {164872127070012814ULL, 684865078781416357ULL, 165377610071014801ULL},
+    {211700001661267466ULL, 854536981983709561ULL, 13449158470240342ULL},
+    {271828182845904523ULL, 536028747135266249ULL, 775724709369995957ULL},
+    {349034295746184137ULL, 613054602967226548ULL, 265173439876235162ULL},
+    {448168907033806482ULL, 260205546011927581ULL, 900574986836966706ULL},
+    {575460267600573043ULL, 686649970484269237ULL, 92292230833652640ULL},
+    {738905609893065022ULL, 723042746057500781ULL, 318031557055184732ULL},
+    {948773583635852572ULL, 55036904451173842ULL, 377022496766238701ULL},
+};
+
+// Верхние оценки корня, умноженные на 100: sqrt(L + 1) и sqrt(10 * (L + 1))
+// для старшей цифры L = 1..9
+static const unsigned int sqrt_upper[2][10] = {
+    {0, 142, 174, 200, 224, 245, 265, 283, 300, 317},
+    {0, 448, 548, 633, 708, 775, 837, 895, 949, 1000},
+};
+
+// Константа из таблицы, округленная до WORK_SCALE
+static void load_constant(const unsigned long long chunks[3],
+                          s21_wide *result) {
+  *result = wide_zero();
+  for (int i = 0; i < 3; i++) {
+    s21_wide chunk;
+    limbs_mul_pow10(result->bits, S21_WIDE_LIMBS, CONSTANT_CHUNK);
+    wide_from_i64((int64_t)chunks[i], &chunk);
+    wide_add(result, &chunk);
+  }
+  result->scale = CONSTANT_SCALE;
+  wide_round_scale(result, WORK_SCALE, S21_ROUND_HALF_EVEN);
+}
+
+// Сравнение широких чисел с учетом знака и scale
+static int wide_compare(const s21_wide *a, const s21_wide *b) {
+  s21_wide diff = *a;
+  wide_sub(&diff, b);
+  return wide_is_zero(&diff) ? 0 : (diff.sign ? -1 : 1);
+}
+
+// Произведение, округленное до WORK_SCALE
+static void mul_work(const s21_wide *a, const s21_wide *b, s21_wide *result) {
+  wide_mul(a, b, result);
+  wide_round_scale(result, WORK_SCALE, S21_ROUND_HALF_EVEN);
+}
+
+// Деление на небольшое целое с округлением до WORK_SCALE
+static void div_work_int(const s21_wide *a, int64_t divisor,
+                         s21_wide *result) {
+  s21_wide wide_divisor;
+  wide_from_i64(divisor, &wide_divisor);
+  wide_div(a, &wide_divisor, WORK_SCALE, S21_ROUND_HALF_EVEN, result);
+}
+
+// Окончательное округление результата (одно) и удаление лишних нулей
+static int finish(const s21_wide *value, s21_decimal *result) {
+  int status = wide_to_decimal(value, S21_ROUND_HALF_EVEN, result);
+  if (status == CodeOK) normalize(result);
+  return status;
+}
+
+// Целочисленный корень floor(sqrt(number)) методом Ньютона. Начальная
+// оценка сверху берется из числа цифр и старшей цифры (таблица sqrt_upper),
+// после этого итерации монотонно убывают до ответа. number >= 10^4
+void wide_isqrt(const s21_wide *number, s21_wide *root) {
+  int digits = wide_digit_count(number);
+  s21_wide leading = *number;
+  wide_round_scale(&leading, -(digits - 1), S21_ROUND_TRUNCATE);
+  // number = l * 10^(digits - 1), 1 <= l < 10; при нечетном показателе
+  // одна степень десяти переходит под корень
+  int odd = (digits - 1) % 2;
+  int power = (digits - 1 - odd) / 2 - 2;
+  wide_from_i64(sqrt_upper[odd][leading.bits[0]], root);
+  limbs_mul_pow10(root->bits, S21_WIDE_LIMBS, power);
+
+  int done = 0;
+  while (!done) {
+    s21_wide next;
+    wide_div(number, root, 0, S21_ROUND_TRUNCATE, &next);
+    wide_add(&next, root);
+    limbs_div_u32(next.bits, S21_WIDE_LIMBS, 2);
+    if (wide_compare(&next, root) >= 0) {
+      done = 1;
+    } else {
+      *root = next;
+    }
+  }
+}
+
+// Квадратный корень, правильно округленный (банковское округление).
+// Для отрицательного аргумента - CodeInvalidData
+int s21_sqrt(s21_decimal value, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  *result = decimal_zero();
+  if (is_zero(value)) return CodeOK;
+  if (get_sign(value)) return CodeInvalidData;
+
+  // value = m * 10^-s лежит в [10^(e - 1), 10^e). Корень считается как
+  // целый корень из m * 10^(2t - s) с t знаками после запятой, t выбирается
+  // так, чтобы в корне было не меньше 30 цифр
+  int scale = get_scale(value);
+  int exponent = s21_digit_count(value) - scale;
+  int half = (exponent >= 0) ? exponent / 2 : -((1 - exponent) / 2);
+  int target = 31 - half;
+  if (target < 28) target = 28;
+
+  s21_wide number;
+  s21_wide root;
+  s21_wide square;
+  wide_from_decimal(value, &number);
+  number.scale = 0;
+  limbs_mul_pow10(number.bits, S21_WIDE_LIMBS, 2 * target - scale);
+  wide_isqrt(&number, &root);
+
+  // Признак неточности дописывается младшей цифрой, чтобы отбрасывание
+  // цифр при переводе в decimal округляло как точный корень
+  wide_mul(&root, &root, &square);
+  int sticky = (wide_compare(&square, &number) != 0);
+  limbs_mul_pow10(root.bits, S21_WIDE_LIMBS, 1);
+  root.bits[0] += (unsigned int)sticky;
+  root.scale = target + 1;
+  return finish(&root, result);
+}
+
+// exp(value) для value >= 0 в виде mantissa * 10^power, mantissa < 13.
+// value = q * ln(10) + j / 4 + f, 0 <= f < 1/4; exp(f) считается рядом
+// Тейлора, exp(j / 4) берется из таблицы
+static void exp_reduced(const s21_wide *value, s21_wide *mantissa,
+                        int *power) {
+  s21_wide ln10;
+  s21_wide quotient;
+  s21_wide rest;
+  s21_wide part;
+  load_constant(ln10_chunks, &ln10);
+  wide_div(value, &ln10, 0, S21_ROUND_TRUNCATE, &quotient);
+  *power = (int)quotient.bits[0];
+
+  rest = *value;
+  wide_mul(&quotient, &ln10, &part);
+  wide_sub(&rest, &part);
+
+  s21_wide quarters;
+  s21_wide four;
+  wide_from_i64(4, &four);
+  wide_mul(&rest, &four, &quarters);
+  wide_round_scale(&quarters, 0, S21_ROUND_TRUNCATE);
+  int j = (int)quarters.bits[0];
+  wide_from_i64(25 * j, &part);
+  part.scale = 2;
+  wide_sub(&rest, &part);
+  wide_round_scale(&rest, WORK_SCALE, S21_ROUND_HALF_EVEN);
+
+  s21_wide term;
+  wide_from_i64(1, mantissa);
+  wide_from_i64(1, &term);
+  for (int n = 1; !wide_is_zero(&term); n++) {
+    s21_wide product;
+    mul_work(&term, &rest, &product);
+    div_work_int(&product, n, &term);
+    wide_add(mantissa, &term);
+  }
+
+  if (j > 0) {
+    s21_wide point;
+    s21_wide product;
+    load_constant(exp_quarter_chunks[j - 1], &point);
+    mul_work(mantissa, &point, &product);
+    *mantissa = product;
+  }
+}
+
+// Экспонента. Для value > 67 результат не помещается в decimal
+// (CodeBigNumber), для value < -67 он округляется до нуля
+int s21_exp(s21_decimal value, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  *result = decimal_zero();
+
+  s21_wide argument;
+  s21_wide limit;
+  wide_from_decimal(value, &argument);
+  int sign = argument.sign;
+  argument.sign = 0;
+  wide_from_i64(67, &limit);
+  if (wide_compare(&argument, &limit) > 0) {
+    return sign ? CodeOK : CodeBigNumber;
+  }
+
+  s21_wide mantissa;
+  int power = 0;
+  exp_reduced(&argument, &mantissa, &power);
+  if (sign) {
+    s21_wide one;
+    s21_wide inverse;
+    wide_from_i64(1, &one);
+    wide_div(&one, &mantissa, WORK_SCALE, S21_ROUND_HALF_EVEN, &inverse);
+    mantissa = inverse;
+    mantissa.scale += power;
+  } else {
+    mantissa.scale -= power;
+  }
+  return finish(&mantissa, result);
+}
+
+// Натуральный логарифм положительного числа с точностью WORK_SCALE.
+// value = y * 10^e, 1 <= y < 10; y сравнивается с таблицей exp(j / 4), и
+// ln(y) = j / 4 + 2 * atanh((y - c) / (y + c)), c = exp(j / 4), |z| < 0.125
+static void ln_wide(s21_decimal value, s21_wide *result) {
+  int digits = s21_digit_count(value);
+  int exponent = digits - 1 - get_scale(value);
+  s21_wide y;
+  s21_wide point;
+  wide_from_decimal(value, &y);
+  y.scale = digits - 1;
+
+  int j = 9;
+  load_constant(exp_quarter_chunks[j - 1], &point);
+  while (j > 0 && wide_compare(&y, &point) < 0) {
+    j--;
+    if (j > 0) {
+      load_constant(exp_quarter_chunks[j - 1], &point);
+    } else {
+      wide_from_i64(1, &point);
+    }
+  }
+
+  s21_wide numerator = y;
+  s21_wide denominator = y;
+  s21_wide z;
+  s21_wide z_squared;
+  wide_sub(&numerator, &point);
+  wide_add(&denominator, &point);
+  wide_div(&numerator, &denominator, WORK_SCALE, S21_ROUND_HALF_EVEN, &z);
+  mul_work(&z, &z, &z_squared);
+
+  // atanh(z) = z + z^3 / 3 + z^5 / 5 + ...
+  s21_wide sum = z;
+  s21_wide power = z;
+  s21_wide term = z;
+  for (int k = 3; !wide_is_zero(&term); k += 2) {
+    s21_wide product;
+    mul_work(&power, &z_squared, &product);
+    power = product;
+    div_work_int(&power, k, &term);
+    wide_add(&sum, &term);
+  }
+
+  s21_wide two;
+  s21_wide part;
+  wide_from_i64(2, &two);
+  wide_mul(&sum, &two, result);
+  wide_from_i64(25 * j, &part);
+  part.scale = 2;
+  wide_add(result, &part);
+  if (exponent != 0) {
+    s21_wide ln10;
+    s21_wide wide_exponent;
+    load_constant(ln10_chunks, &ln10);
+    wide_from_i64(exponent, &wide_exponent);
+    wide_mul(&ln10, &wide_exponent, &part);
+    wide_add(result, &part);
+  }
+}
+
+// Проверка аргумента логарифма: ноль - CodeSmallNumber (минус
+// бесконечность), отрицательное число - CodeInvalidData
+static int ln_domain(s21_decimal value) {
+  int status = CodeOK;
+  if (is_zero(value)) {
+    status = CodeSmallNumber;
+  } else if (get_sign(value)) {
+    status = CodeInvalidData;
+  }
+  return status;
+}
+
+// Натуральный логарифм
+int s21_ln(s21_decimal value, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  *result = decimal_zero();
+  int status = ln_domain(value);
+  if (status == CodeOK) {
+    s21_wide logarithm;
+    ln_wide(value, &logarithm);
+    status = finish(&logarithm, result);
+  }
+  return status;
+}
+
+// Десятичный логарифм: ln(value) / ln(10). Для степеней десяти ряд дает
+// ноль, и результат получается точным целым
+int s21_log10(s21_decimal value, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  *result = decimal_zero();
+  int status = ln_domain(value);
+  if (status == CodeOK) {
+    s21_wide logarithm;
+    s21_wide ln10;
+    s21_wide quotient;
+    ln_wide(value, &logarithm);
+    load_constant(ln10_chunks, &ln10);
+    wide_div(&logarithm, &ln10, WORK_SCALE, S21_ROUND_HALF_EVEN, &quotient);
+    status = finish(&quotient, result);
+  }
+  return status;
+}
+
+// Пакетные версии
+
+typedef int (*s21_unary_operation)(s21_decimal, s21_decimal *);
+
+typedef struct {
+  s21_unary_operation operation;
+  const s21_decimal *in;
+  s21_decimal *out;
+} unary_batch;
+
+static int unary_element(const void *context, size_t index) {
+  const unary_batch *batch = context;
+  return batch->operation(batch->in[index], &batch->out[index]);
+}
+
+static int apply_unary_n(s21_unary_operation operation, const s21_decimal *in,
+                         s21_decimal *out, int *codes, size_t n,
+                         const s21_exec_policy *policy) {
+  if (n > 0 && (!in || !out)) return CodeInvalidData;
+  unary_batch batch = {operation, in, out};
+  return batch_apply(policy, n, S21_COST_TRANSCENDENTAL, unary_element,
+                     &batch, codes);
+}
+
+int s21_sqrt_n(const s21_decimal *in, s21_decimal *out, int *codes,
+               size_t n, const s21_exec_policy *policy) {
+  return apply_unary_n(s21_sqrt, in, out, codes, n, policy);
+}
+
+int s21_exp_n(const s21_decimal *in, s21_decimal *out, int *codes, size_t n,
+              const s21_exec_policy *policy) {
+  return apply_unary_n(s21_exp, in, out, codes, n, policy);
+}
+
+int s21_ln_n(const s21_decimal *in, s21_decimal *out, int *codes, size_t n,
+             const s21_exec_policy *policy) {
+  return apply_unary_n(s21_ln, in, out, codes, n, policy);
+}
+
+int s21_log10_n(const s21_decimal *in, s21_decimal *out, int *codes,
+                size_t n, const s21_exec_policy *policy) {
+  return apply_unary_n(s21_log10, in, out, codes, n, policy);
+}
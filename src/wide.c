@@ -0,0 +1,476 @@
+#include "s21_decimal_inline.h"
+
+// Широкие числа: модуль до 512 бит, знак и произвольный scale.
+// Используются как точные промежуточные значения и накопители, чтобы
+// округлять результат один раз в конце
+
+// Создание нулевого широкого числа
+s21_wide wide_zero() {
+  s21_wide result = {{0}, 0, 0};
+  return result;
+}
+
+// Перевод decimal в широкое число (без потери точности)
+void wide_from_decimal(s21_decimal value, s21_wide *result) {
+  *result = wide_zero();
+  for (int i = 0; i < 3; i++) result->bits[i] = value.bits[i];
+  result->scale = get_scale(value);
+  result->sign = is_zero(value) ? 0 : get_sign(value);
+}
+
+// Перевод целого числа в широкое число со scale 0
+void wide_from_i64(int64_t value, s21_wide *result) {
+  unsigned long long magnitude = (value < 0)
+                                     ? 0ULL - (unsigned long long)value
+                                     : (unsigned long long)value;
+  *result = wide_zero();
+  result->bits[0] = (unsigned int)magnitude;
+  result->bits[1] = (unsigned int)(magnitude >> 32);
+  result->sign = (value < 0);
+}
+
+// Количество значащих слов модуля
+static int wide_length(const unsigned int *bits) {
+  int length = S21_WIDE_LIMBS;
+  while (length > 0 && bits[length - 1] == 0) length--;
+  return length;
+}
+
+// Ненулевой, если модуль не помещается в 96 бит. Без раннего выхода из
+// цикла, чтобы компилятор мог его векторизовать
+static unsigned int wide_high_limbs(const unsigned int *bits) {
+  unsigned int high = 0;
+  for (int i = 3; i < S21_WIDE_LIMBS; i++) high |= bits[i];
+  return high;
+}
+
+int wide_is_zero(const s21_wide *value) {
+  return wide_length(value->bits) == 0;
+}
+
+// Длина модуля в битах
+int wide_bit_length(const s21_wide *value) {
+  int length = wide_length(value->bits);
+  int bits = 0;
+  if (length > 0) {
+    bits = 32 * length - __builtin_clz(value->bits[length - 1]);
+  }
+  return bits;
+}
+
+// Сравнение модулей (без учета знака и scale)
+static int mag_compare(const unsigned int *a, const unsigned int *b) {
+  int result = 0;
+  for (int i = S21_WIDE_LIMBS - 1; i >= 0 && result == 0; i--) {
+    if (a[i] != b[i]) result = (a[i] > b[i]) ? 1 : -1;
+  }
+  return result;
+}
+
+// a += b, возвращает перенос из старшего слова
+static int mag_add(unsigned int *a, const unsigned int *b) {
+  unsigned long long carry = 0;
+  for (int i = 0; i < S21_WIDE_LIMBS; i++) {
+    unsigned long long sum = (unsigned long long)a[i] + b[i] + carry;
+    a[i] = (unsigned int)sum;
+    carry = sum >> 32;
+  }
+  return (int)carry;
+}
+
+// result = a - b (a >= b), result может совпадать с a или b
+static void mag_sub(const unsigned int *a, const unsigned int *b,
+                    unsigned int *result) {
+  unsigned long long borrow = 0;
+  for (int i = 0; i < S21_WIDE_LIMBS; i++) {
+    unsigned long long diff = (unsigned long long)a[i] - b[i] - borrow;
+    result[i] = (unsigned int)diff;
+    borrow = (diff >> 32) & 1;
+  }
+}
+
+// Код переполнения в зависимости от знака
+static int overflow_code(int sign) {
+  return sign ? CodeSmallNumber : CodeBigNumber;
+}
+
+// Повышение scale до scale без потери точности (умножением на 10^k)
+int wide_upscale(s21_wide *value, int scale) {
+  int status = CodeOK;
+  if (scale > value->scale) {
+    status = limbs_mul_pow10(value->bits, S21_WIDE_LIMBS, scale - value->scale);
+    if (status == CodeOK) {
+      value->scale = scale;
+    } else {
+      status = overflow_code(value->sign);
+    }
+  }
+  return status;
+}
+
+// Понижение scale до scale с округлением в режиме mode (или повышение)
+int wide_round_scale(s21_wide *value, int scale, s21_rounding_mode mode) {
+  int status = CodeOK;
+  if (scale >= value->scale) {
+    status = wide_upscale(value, scale);
+  } else {
+    int sticky = 0;
+    int guard = limbs_div_pow10(value->bits, S21_WIDE_LIMBS,
+                                value->scale - scale, &sticky);
+    if (rounding_increment(guard, sticky, value->bits[0] & 1, value->sign,
+                           mode)) {
+      limbs_increment(value->bits, S21_WIDE_LIMBS);
+    }
+    value->scale = scale;
+    if (wide_is_zero(value)) value->sign = 0;
+  }
+  return status;
+}
+
+// Количество десятичных цифр модуля (у нуля одна цифра)
+int wide_digit_count(const s21_wide *value) {
+  int bits = wide_bit_length(value);
+  int digits = 1;
+  if (bits > 0) {
+    int estimate = (bits * 1233) >> 12;
+    unsigned int power[S21_WIDE_LIMBS] = {1};
+    limbs_mul_pow10(power, S21_WIDE_LIMBS, estimate);
+    digits = estimate + (mag_compare(value->bits, power) >= 0);
+  }
+  return digits;
+}
+
+// Округление до digits значащих цифр (scale уменьшается на число
+// отброшенных цифр и может стать отрицательным)
+void wide_round_digits(s21_wide *value, int digits, s21_rounding_mode mode) {
+  int extra = wide_digit_count(value) - digits;
+  if (extra > 0) wide_round_scale(value, value->scale - extra, mode);
+}
+
+// acc += value с точным выравниванием scale
+int wide_add(s21_wide *acc, const s21_wide *value) {
+  s21_wide addend = *value;
+  int status = CodeOK;
+  if (addend.scale > acc->scale) {
+    status = wide_upscale(acc, addend.scale);
+  } else if (addend.scale < acc->scale) {
+    status = wide_upscale(&addend, acc->scale);
+  }
+
+  if (status == CodeOK) {
+    if (acc->sign == addend.sign) {
+      if (mag_add(acc->bits, addend.bits)) status = overflow_code(acc->sign);
+    } else if (mag_compare(acc->bits, addend.bits) >= 0) {
+      mag_sub(acc->bits, addend.bits, acc->bits);
+    } else {
+      mag_sub(addend.bits, acc->bits, acc->bits);
+      acc->sign = addend.sign;
+    }
+    if (wide_is_zero(acc)) acc->sign = 0;
+  }
+  return status;
+}
+
+// acc -= value
+int wide_sub(s21_wide *acc, const s21_wide *value) {
+  s21_wide negated = *value;
+  if (!wide_is_zero(&negated)) negated.sign = !negated.sign;
+  return wide_add(acc, &negated);
+}
+
+// acc += value при равных scale: три слова складываются или вычитаются с
+// переносом в старшие, без выравнивания и копии всех 16 слов
+static int wide_add_short(s21_wide *acc, s21_decimal value) {
+  int sign = get_sign(value);
+  int status = CodeOK;
+  if (sign == acc->sign || is_zero(value)) {
+    unsigned long long carry = 0;
+    for (int i = 0; i < S21_WIDE_LIMBS && (i < 3 || carry); i++) {
+      carry += (unsigned long long)acc->bits[i] + (i < 3 ? value.bits[i] : 0);
+      acc->bits[i] = (unsigned int)carry;
+      carry >>= 32;
+    }
+    if (carry) status = overflow_code(acc->sign);
+  } else {
+    int order = wide_high_limbs(acc->bits) ? 1 : 0;
+    for (int i = 2; i >= 0 && order == 0; i--) {
+      if (acc->bits[i] != value.bits[i]) {
+        order = (acc->bits[i] > value.bits[i]) ? 1 : -1;
+      }
+    }
+    unsigned long long borrow = 0;
+    if (order >= 0) {
+      for (int i = 0; i < S21_WIDE_LIMBS && (i < 3 || borrow); i++) {
+        unsigned long long diff = (unsigned long long)acc->bits[i] -
+                                  (i < 3 ? value.bits[i] : 0) - borrow;
+        acc->bits[i] = (unsigned int)diff;
+        borrow = (diff >> 32) & 1;
+      }
+    } else {
+      for (int i = 0; i < 3; i++) {
+        unsigned long long diff =
+            (unsigned long long)value.bits[i] - acc->bits[i] - borrow;
+        acc->bits[i] = (unsigned int)diff;
+        borrow = (diff >> 32) & 1;
+      }
+      acc->sign = sign;
+    }
+    if (order == 0) acc->sign = 0;
+  }
+  return status;
+}
+
+// acc += value для decimal
+int wide_add_decimal(s21_wide *acc, s21_decimal value) {
+  int status = CodeOK;
+  if (get_scale(value) == acc->scale) {
+    status = wide_add_short(acc, value);
+  } else {
+    s21_wide addend;
+    wide_from_decimal(value, &addend);
+    status = wide_add(acc, &addend);
+  }
+  return status;
+}
+
+// result = a * b (точно, scale складываются)
+int wide_mul(const s21_wide *a, const s21_wide *b, s21_wide *result) {
+  unsigned int product[2 * S21_WIDE_LIMBS] = {0};
+  int length_a = wide_length(a->bits);
+  int length_b = wide_length(b->bits);
+  for (int i = 0; i < length_a; i++) {
+    unsigned long long carry = 0;
+    for (int j = 0; j < length_b; j++) {
+      unsigned long long cur = (unsigned long long)a->bits[i] * b->bits[j] +
+                               product[i + j] + carry;
+      product[i + j] = (unsigned int)cur;
+      carry = cur >> 32;
+    }
+    product[i + length_b] = (unsigned int)carry;
+  }
+
+  int status = CodeOK;
+  int sign = a->sign ^ b->sign;
+  for (int i = S21_WIDE_LIMBS; i < 2 * S21_WIDE_LIMBS; i++) {
+    if (product[i] != 0) status = overflow_code(sign);
+  }
+  if (status == CodeOK) {
+    *result = wide_zero();
+    for (int i = 0; i < S21_WIDE_LIMBS; i++) result->bits[i] = product[i];
+    result->scale = a->scale + b->scale;
+    result->sign = wide_is_zero(result) ? 0 : sign;
+  }
+  return status;
+}
+
+// Деление модулей (алгоритм D Кнута, слова по 32 бита).
+// u - делимое из m слов, v - делитель из n слов (v[n - 1] != 0, m >= n).
+// q получает m - n + 1 слов частного, r - n слов остатка
+static void mag_divmod(const unsigned int *u, int m, const unsigned int *v,
+                       int n, unsigned int *q, unsigned int *r) {
+  const unsigned long long base = 0x100000000ULL;
+  if (n == 1) {
+    unsigned long long rem = 0;
+    for (int j = m - 1; j >= 0; j--) {
+      unsigned long long cur = (rem << 32) | u[j];
+      q[j] = (unsigned int)(cur / v[0]);
+      rem = cur % v[0];
+    }
+    r[0] = (unsigned int)rem;
+  } else {
+    // Нормализация: старший бит делителя должен быть единицей
+    int s = __builtin_clz(v[n - 1]);
+    unsigned int vn[S21_WIDE_LIMBS] = {0};
+    unsigned int un[S21_WIDE_LIMBS + 1] = {0};
+    for (int i = n - 1; i > 0; i--) {
+      vn[i] = (v[i] << s) | (unsigned int)((unsigned long long)v[i - 1] >>
+                                           (32 - s));
+    }
+    vn[0] = v[0] << s;
+    un[m] = (unsigned int)((unsigned long long)u[m - 1] >> (32 - s));
+    for (int i = m - 1; i > 0; i--) {
+      un[i] = (u[i] << s) | (unsigned int)((unsigned long long)u[i - 1] >>
+                                           (32 - s));
+    }
+    un[0] = u[0] << s;
+
+    for (int j = m - n; j >= 0; j--) {
+      unsigned long long top = ((unsigned long long)un[j + n] << 32) |
+                               un[j + n - 1];
+      unsigned long long qhat = top / vn[n - 1];
+      unsigned long long rhat = top % vn[n - 1];
+      // Уточнение оценки qhat по двум старшим словам делителя
+      while (rhat < base &&
+             (qhat >= base ||
+              qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))) {
+        qhat--;
+        rhat += vn[n - 1];
+      }
+
+      // Вычитание qhat * vn из un[j..j + n]
+      long long borrow = 0;
+      for (int i = 0; i < n; i++) {
+        unsigned long long p = qhat * vn[i];
+        long long t =
+            (long long)un[i + j] - borrow - (long long)(p & 0xFFFFFFFF);
+        un[i + j] = (unsigned int)t;
+        borrow = (long long)(p >> 32) - (t >> 32);
+      }
+      long long t = (long long)un[j + n] - borrow;
+      un[j + n] = (unsigned int)t;
+
+      q[j] = (unsigned int)qhat;
+      if (t < 0) {
+        // qhat оказался на единицу больше - возвращаем делитель
+        q[j]--;
+        unsigned long long carry = 0;
+        for (int i = 0; i < n; i++) {
+          unsigned long long sum =
+              (unsigned long long)un[i + j] + vn[i] + carry;
+          un[i + j] = (unsigned int)sum;
+          carry = sum >> 32;
+        }
+        un[j + n] += (unsigned int)carry;
+      }
+    }
+
+    for (int i = 0; i < n - 1; i++) {
+      r[i] = (un[i] >> s) |
+             (unsigned int)((unsigned long long)un[i + 1] << (32 - s));
+    }
+    r[n - 1] = un[n - 1] >> s;
+  }
+}
+
+// result = dividend / divisor со scale результата scale и округлением в
+// режиме mode (одно деление, одно округление)
+int wide_div(const s21_wide *dividend, const s21_wide *divisor, int scale,
+             s21_rounding_mode mode, s21_wide *result) {
+  if (wide_is_zero(divisor)) return CodeDivisionZero;
+
+  int status = CodeOK;
+  int sign = dividend->sign ^ divisor->sign;
+  s21_wide u = *dividend;
+  s21_wide v = *divisor;
+  // u / v * 10^(scale - su + sv): недостающая степень переносится в делимое
+  // или делитель
+  int shift = scale - dividend->scale + divisor->scale;
+  if (shift > 0) {
+    if (limbs_mul_pow10(u.bits, S21_WIDE_LIMBS, shift) != CodeOK) {
+      status = overflow_code(sign);
+    }
+  } else if (shift < 0) {
+    if (limbs_mul_pow10(v.bits, S21_WIDE_LIMBS, -shift) != CodeOK) {
+      // Делитель больше любого делимого - частное ноль, остаток - делимое
+      for (int i = 0; i < S21_WIDE_LIMBS; i++) v.bits[i] = 0xFFFFFFFFu;
+    }
+  }
+
+  if (status == CodeOK) {
+    *result = wide_zero();
+    result->scale = scale;
+    unsigned int rem[S21_WIDE_LIMBS] = {0};
+    int m = wide_length(u.bits);
+    int n = wide_length(v.bits);
+    if (m >= n) {
+      mag_divmod(u.bits, m, v.bits, n, result->bits, rem);
+    } else {
+      for (int i = 0; i < S21_WIDE_LIMBS; i++) rem[i] = u.bits[i];
+    }
+
+    // Сравнение остатка с половиной делителя: rem против v - rem
+    unsigned int rest[S21_WIDE_LIMBS];
+    mag_sub(v.bits, rem, rest);
+    int half_cmp = mag_compare(rem, rest);
+    int inexact = (wide_length(rem) != 0);
+    if (rounding_increment_by_half(half_cmp, inexact, result->bits[0] & 1,
+                                   sign, mode)) {
+      if (limbs_increment(result->bits, S21_WIDE_LIMBS)) {
+        status = overflow_code(sign);
+      }
+    }
+    result->sign = wide_is_zero(result) ? 0 : sign;
+  }
+  return status;
+}
+
+// Округление с отбрасыванием drop цифр; возвращает 1, если результат
+// помещается в 96 бит
+static int drop_digits_to_96(const s21_wide *value, int drop,
+                             s21_rounding_mode mode, s21_wide *result) {
+  *result = *value;
+  if (drop > 0) wide_round_scale(result, value->scale - drop, mode);
+  return wide_length(result->bits) <= 3;
+}
+
+// Перевод широкого числа в decimal с одним округлением в режиме mode:
+// отбрасывается столько младших цифр, чтобы scale был не больше max_scale
+// (0..28), а модуль помещался в 96 бит
+int wide_to_decimal_scale(const s21_wide *value, int max_scale,
+                          s21_rounding_mode mode, s21_decimal *result) {
+  if (!result) return CodeInvalidData;
+  *result = decimal_zero();
+
+  int status = CodeOK;
+  s21_wide rounded = *value;
+  // Значение, которое уже помещается в decimal, копируется без подсчета цифр
+  int fits = value->scale >= 0 && value->scale <= max_scale &&
+             !wide_high_limbs(value->bits);
+  if (value->scale < 0) {
+    status = wide_upscale(&rounded, 0);
+    if (status == CodeOK && wide_length(rounded.bits) > 3) {
+      status = overflow_code(value->sign);
+    }
+  } else if (!fits) {
+    int drop = value->scale - max_scale;
+    int excess = wide_digit_count(value) - 29;
+    if (excess > drop) drop = excess;
+    if (drop < 0) drop = 0;
+    // Оценка по числу цифр ошибается не больше чем на одну цифру, еще одна
+    // может понадобиться, если округление вверх дало 2^96
+    while (drop <= value->scale && !drop_digits_to_96(value, drop, mode,
+                                                      &rounded)) {
+      drop++;
+    }
+    if (drop > value->scale) status = overflow_code(value->sign);
+  }
+
+  if (status == CodeOK) {
+    for (int i = 0; i < 3; i++) result->bits[i] = rounded.bits[i];
+    set_scale(result, rounded.scale);
+    if (!is_zero(*result)) set_sign(result, rounded.sign);
+  }
+  return status;
+}
+
+int wide_to_decimal(const s21_wide *value, s21_rounding_mode mode,
+                    s21_decimal *result) {
+  return wide_to_decimal_scale(value, 28, mode, result);
+}
+
+// dividend / divisor в decimal с одним округлением: частное считается со
+// scale, а если оно не помещается в 96 бит, деление повторяется с меньшим
+// scale (как у s21_div). Округлять до decimal частное, уже округленное до
+// scale, значило бы округлять дважды
+int wide_div_to_decimal(const s21_wide *dividend, const s21_wide *divisor,
+                        int scale, s21_rounding_mode mode,
+                        s21_decimal *result) {
+  s21_wide quotient;
+  int status = wide_div(dividend, divisor, scale, mode, &quotient);
+  int fits = status != CodeOK || wide_length(quotient.bits) <= 3;
+  // Оценка по числу цифр, как в wide_to_decimal, уточняется по одной цифре
+  int drop = fits ? 0 : wide_digit_count(&quotient) - 29;
+  if (drop < 1) drop = 1;
+  while (!fits) {
+    if (drop > scale) {
+      status = overflow_code(quotient.sign);
+      fits = 1;
+    } else {
+      status = wide_div(dividend, divisor, scale - drop, mode, &quotient);
+      fits = status != CodeOK || wide_length(quotient.bits) <= 3;
+      drop++;
+    }
+  }
+  if (status == CodeOK) status = wide_to_decimal(&quotient, mode, result);
+  return status;
+}
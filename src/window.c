@@ -0,0 +1,209 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "s21_decimal_inline.h"
+
+// Начальная емкость окна по времени
+#define WINDOW_MIN_CAPACITY 16
+
+static void total_reset(s21_window_total *total) {
+  memset(total, 0, sizeof(*total));
+  total->sum = wide_zero();
+}
+
+// Добавление (remove = 0) или удаление слагаемого: decimal (через быстрый
+// путь wide_add_decimal при равных scale) или, если decimal = NULL,
+// широкого term. Scale суммы всегда равен наибольшему scale слагаемых
+// окна: когда уходит последнее слагаемое с ним, сумма делится на степень
+// 10 без остатка, остальные слагаемые короче
+static int total_update(s21_window_total *total, const s21_decimal *decimal,
+                        const s21_wide *term, int remove) {
+  int scale = decimal ? get_scale(*decimal) : term->scale;
+  int status = CodeOK;
+  if (decimal) {
+    s21_decimal addend = *decimal;
+    if (remove) addend.bits[3] ^= 1u << 31;
+    status = wide_add_decimal(&total->sum, addend);
+  } else {
+    status = remove ? wide_sub(&total->sum, term) : wide_add(&total->sum, term);
+  }
+  if (!remove) {
+    total->scales[scale]++;
+  } else {
+    total->scales[scale]--;
+    int top = total->sum.scale;
+    while (top > 0 && total->scales[top] == 0) top--;
+    if (status == CodeOK && top < total->sum.scale) {
+      status = wide_round_scale(&total->sum, top, S21_ROUND_HALF_EVEN);
+    }
+  }
+  return status;
+}
+
+// Элемент entry входит в суммы (remove = 0) или уходит из них
+static int entry_apply(s21_window_total totals[3],
+                       const s21_window_entry *entry, int remove) {
+  s21_wide value;
+  s21_wide weight;
+  s21_wide product;
+  wide_from_decimal(entry->value, &value);
+  wide_from_decimal(entry->weight, &weight);
+  int status = wide_mul(&value, &weight, &product);
+  if (status == CodeOK) {
+    status = total_update(&totals[0], &entry->value, NULL, remove);
+  }
+  if (status == CodeOK) {
+    status = total_update(&totals[1], &entry->weight, NULL, remove);
+  }
+  if (status == CodeOK) {
+    status = total_update(&totals[2], NULL, &product, remove);
+  }
+  return status;
+}
+
+// Уход removed и приход added (любой может быть NULL) считаются на копиях
+// сумм и записываются в окно только при CodeOK: после ошибки окно
+// остается прежним
+static int window_apply(s21_window *window, const s21_window_entry *removed,
+                        const s21_window_entry *added) {
+  s21_window_total totals[3] = {window->values, window->weights,
+                                window->products};
+  int status = CodeOK;
+  if (removed) status = entry_apply(totals, removed, 1);
+  if (status == CodeOK && added) status = entry_apply(totals, added, 0);
+  if (status == CodeOK) {
+    window->values = totals[0];
+    window->weights = totals[1];
+    window->products = totals[2];
+  }
+  return status;
+}
+
+// Новый буфер вдвое больше, элементы переносятся по порядку с начала
+static int window_grow(s21_window *window) {
+  size_t capacity = window->capacity ? window->capacity * 2
+                                     : WINDOW_MIN_CAPACITY;
+  s21_window_entry *entries = malloc(sizeof(s21_window_entry) * capacity);
+  if (!entries) return CodeInvalidData;
+  for (size_t i = 0; i < window->count; i++) {
+    entries[i] = window->entries[(window->head + i) % window->capacity];
+  }
+  free(window->entries);
+  window->entries = entries;
+  window->capacity = capacity;
+  window->head = 0;
+  return CodeOK;
+}
+
+int s21_window_init(s21_window *window, size_t limit) {
+  if (!window) return CodeInvalidData;
+  memset(window, 0, sizeof(*window));
+  window->limit = limit;
+  s21_window_reset(window);
+  if (limit > 0) {
+    window->entries = malloc(sizeof(s21_window_entry) * limit);
+    window->capacity = window->entries ? limit : 0;
+  }
+  return (limit == 0 || window->entries) ? CodeOK : CodeInvalidData;
+}
+
+void s21_window_free(s21_window *window) {
+  if (window) {
+    free(window->entries);
+    window->entries = NULL;
+    window->capacity = 0;
+    s21_window_reset(window);
+  }
+}
+
+void s21_window_reset(s21_window *window) {
+  if (window) {
+    window->head = 0;
+    window->count = 0;
+    total_reset(&window->values);
+    total_reset(&window->weights);
+    total_reset(&window->products);
+  }
+}
+
+int s21_window_push(s21_window *window, int64_t time, s21_decimal value,
+                    s21_decimal weight) {
+  if (!window || get_scale(value) > 28 || get_scale(weight) > 28) {
+    return CodeInvalidData;
+  }
+  if (window->limit == 0 && window->count == window->capacity &&
+      window_grow(window) != CodeOK) {
+    return CodeInvalidData;
+  }
+  // Полное окно по количеству вытесняет самый старый элемент в том же
+  // шаге, чтобы ошибка не оставила окно без него
+  const s21_window_entry *oldest = NULL;
+  if (window->limit > 0 && window->count == window->limit) {
+    oldest = &window->entries[window->head];
+  }
+  s21_window_entry entry = {time, value, weight};
+  int status = window_apply(window, oldest, &entry);
+  if (status == CodeOK) {
+    if (oldest) {
+      window->head = (window->head + 1) % window->capacity;
+      window->count--;
+    }
+    window->entries[(window->head + window->count) % window->capacity] = entry;
+    window->count++;
+  }
+  return status;
+}
+
+int s21_window_evict(s21_window *window) {
+  if (!window || window->count == 0) return CodeInvalidData;
+  int status = window_apply(window, &window->entries[window->head], NULL);
+  if (status == CodeOK) {
+    window->head = (window->head + 1) % window->capacity;
+    window->count--;
+  }
+  return status;
+}
+
+int s21_window_evict_before(s21_window *window, int64_t time) {
+  if (!window) return CodeInvalidData;
+  int status = CodeOK;
+  while (status == CodeOK && window->count > 0 &&
+         window->entries[window->head].time < time) {
+    status = s21_window_evict(window);
+  }
+  return status;
+}
+
+size_t s21_window_count(const s21_window *window) {
+  return window ? window->count : 0;
+}
+
+int s21_window_sum(const s21_window *window, s21_decimal *result) {
+  if (!window || !result) return CodeInvalidData;
+  return wide_to_decimal(&window->values.sum, S21_ROUND_HALF_EVEN, result);
+}
+
+int s21_window_mean(const s21_window *window, s21_decimal *result) {
+  if (!window || !result) return CodeInvalidData;
+  unsigned long long count = window->count;
+  s21_decimal divisor = {{(unsigned int)count, (unsigned int)(count >> 32), 0,
+                          0}};
+  s21_decimal sum;
+  int status = s21_window_sum(window, &sum);
+  if (status == CodeOK) status = s21_div(sum, divisor, result);
+  return status;
+}
+
+int s21_window_vwap(const s21_window *window, s21_decimal *result) {
+  if (!window || !result) return CodeInvalidData;
+  s21_decimal products;
+  s21_decimal weights;
+  int status =
+      wide_to_decimal(&window->products.sum, S21_ROUND_HALF_EVEN, &products);
+  if (status == CodeOK) {
+    status =
+        wide_to_decimal(&window->weights.sum, S21_ROUND_HALF_EVEN, &weights);
+  }
+  if (status == CodeOK) status = s21_div(products, weights, result);
+  return status;
+}
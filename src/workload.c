@@ -0,0 +1,337 @@
+#include <math.h>
+#include <string.h>
+
+#include "s21_decimal_inline.h"
+
+// Следующее 64-битное число (splitmix64)
+static uint64_t next_random(s21_workload *workload) {
+  uint64_t z = (workload->state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Равномерное число из (0, 1)
+static double next_uniform(s21_workload *workload) {
+  return ((double)(next_random(workload) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// Целое из [0, bound)
+static unsigned int next_below(s21_workload *workload, unsigned int bound) {
+  return (unsigned int)(next_random(workload) % bound);
+}
+
+// Стандартное нормальное распределение (преобразование Бокса - Мюллера)
+static double next_normal(s21_workload *workload) {
+  double u = next_uniform(workload);
+  double v = next_uniform(workload);
+  return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+// Логнормальная величина с медианой median и разбросом sigma
+static double next_lognormal(s21_workload *workload, double median,
+                             double sigma) {
+  return median * exp(sigma * next_normal(workload));
+}
+
+// Положительное число value, округленное до scale знаков
+static s21_decimal decimal_from_double(double value, int scale, int sign) {
+  s21_decimal result = decimal_zero();
+  double scaled = value * pow(10.0, scale) + 0.5;
+  unsigned long long mantissa =
+      (scaled < 1.8e19) ? (unsigned long long)scaled : 18000000000000000000ULL;
+  result.bits[0] = (unsigned int)mantissa;
+  result.bits[1] = (unsigned int)(mantissa >> 32);
+  set_scale(&result, scale);
+  if (mantissa != 0) set_sign(&result, sign);
+  return result;
+}
+
+// Цена: медиана 50, scale по шагу цены (дешевые бумаги котируются
+// точнее)
+static s21_decimal next_price(s21_workload *workload) {
+  double price = next_lognormal(workload, 50.0, 1.2);
+  if (price < 0.0001) price = 0.0001;
+  if (price > 1e6) price = 1e6;
+  int scale = (price < 1.0) ? 4 : (price < 10000.0) ? 2 : 0;
+  return decimal_from_double(price, scale, 0);
+}
+
+// Количество: чаще всего кратно лоту 100, иногда нечетное
+static s21_decimal next_quantity(s21_workload *workload) {
+  double quantity = next_lognormal(workload, 300.0, 1.5);
+  if (quantity < 1.0) quantity = 1.0;
+  if (quantity > 1e7) quantity = 1e7;
+  unsigned int lots = (unsigned int)quantity;
+  if (next_below(workload, 4) != 0 && lots >= 100) lots -= lots % 100;
+  s21_decimal result = decimal_zero();
+  result.bits[0] = lots;
+  return result;
+}
+
+// Курс валюты около 1 (от сотых до сотен), 5-8 знаков после запятой
+static s21_decimal next_fx_rate(s21_workload *workload) {
+  double rate = next_lognormal(workload, 1.0, 1.5);
+  if (rate < 0.001) rate = 0.001;
+  if (rate > 1000.0) rate = 1000.0;
+  return decimal_from_double(rate, 5 + (int)next_below(workload, 4), 0);
+}
+
+// Полноразрядная сумма: случайная 96-битная мантисса, scale 0..10
+static s21_decimal next_notional(s21_workload *workload) {
+  uint64_t low = next_random(workload);
+  s21_decimal result = decimal_zero();
+  result.bits[0] = (unsigned int)low;
+  result.bits[1] = (unsigned int)(low >> 32);
+  result.bits[2] = (unsigned int)next_random(workload);
+  set_scale(&result, (int)next_below(workload, 11));
+  return result;
+}
+
+// Прибыль или убыток: логнормальный модуль, знак равновероятен
+static s21_decimal next_pnl(s21_workload *workload) {
+  double amount = next_lognormal(workload, 1000.0, 2.0);
+  if (amount > 1e12) amount = 1e12;
+  int sign = (int)next_below(workload, 2);
+  return decimal_from_double(amount, 2, sign);
+}
+
+void s21_workload_init(s21_workload *workload, uint64_t seed) {
+  workload->state = seed;
+}
+
+s21_decimal s21_workload_next(s21_workload *workload, s21_workload_kind kind) {
+  if (kind == S21_WORKLOAD_MIXED) {
+    // 40% цен, 25% количеств, 15% курсов, 15% P&L и 5% крупных сумм
+    unsigned int pick = next_below(workload, 100);
+    kind = (pick < 40)   ? S21_WORKLOAD_PRICE
+           : (pick < 65) ? S21_WORKLOAD_QUANTITY
+           : (pick < 80) ? S21_WORKLOAD_FX_RATE
+           : (pick < 95) ? S21_WORKLOAD_PNL
+                         : S21_WORKLOAD_NOTIONAL;
+  }
+
+  s21_decimal result = decimal_zero();
+  switch (kind) {
+    case S21_WORKLOAD_PRICE:
+      result = next_price(workload);
+      break;
+    case S21_WORKLOAD_QUANTITY:
+      result = next_quantity(workload);
+      break;
+    case S21_WORKLOAD_FX_RATE:
+      result = next_fx_rate(workload);
+      break;
+    case S21_WORKLOAD_NOTIONAL:
+      result = next_notional(workload);
+      break;
+    case S21_WORKLOAD_PNL:
+    default:
+      result = next_pnl(workload);
+      break;
+  }
+  return result;
+}
+
+void s21_workload_fill(s21_workload *workload, s21_workload_kind kind,
+                       s21_decimal *out, size_t n) {
+  for (size_t i = 0; out && i < n; i++) {
+    out[i] = s21_workload_next(workload, kind);
+  }
+}
+
+// Доли операций в трассе (в процентах, по порядку s21_trace_op_code)
+static const unsigned char op_weights[S21_OP_COUNT] = {
+    20, 8, 20, 8, 5, 3, 5, 3, 4, 2, 3, 4, 2, 2, 2, 2, 2, 5};
+
+// Операнды подбираются как в реальных расчетах: P&L складываются,
+// цена умножается на количество, сумма делится на цену или курс
+static void fill_operands(s21_workload *workload, s21_trace_op *op) {
+  unsigned int pick = next_below(workload, 10);
+  switch (op->op) {
+    case S21_OP_ADD:
+    case S21_OP_SUB:
+      op->a = s21_workload_next(
+          workload, pick < 8 ? S21_WORKLOAD_PNL : S21_WORKLOAD_NOTIONAL);
+      op->b = s21_workload_next(workload, S21_WORKLOAD_PNL);
+      break;
+    case S21_OP_MUL:
+      op->a = s21_workload_next(
+          workload, pick < 7 ? S21_WORKLOAD_PRICE : S21_WORKLOAD_NOTIONAL);
+      op->b = s21_workload_next(
+          workload, pick < 7 ? S21_WORKLOAD_QUANTITY : S21_WORKLOAD_FX_RATE);
+      break;
+    case S21_OP_DIV:
+      op->a = s21_workload_next(
+          workload, pick < 5 ? S21_WORKLOAD_NOTIONAL : S21_WORKLOAD_PNL);
+      op->b = s21_workload_next(
+          workload, pick < 5 ? S21_WORKLOAD_PRICE : S21_WORKLOAD_QUANTITY);
+      break;
+    case S21_OP_IS_LESS:
+    case S21_OP_IS_LESS_OR_EQUAL:
+    case S21_OP_IS_GREATER:
+    case S21_OP_IS_GREATER_OR_EQUAL:
+    case S21_OP_IS_EQUAL:
+    case S21_OP_IS_NOT_EQUAL:
+      op->a = s21_workload_next(workload, S21_WORKLOAD_PRICE);
+      // Каждое пятое сравнение - с тем же значением
+      op->b = (pick < 2) ? op->a
+                         : s21_workload_next(workload, S21_WORKLOAD_PRICE);
+      break;
+    default:
+      op->a = s21_workload_next(workload, S21_WORKLOAD_MIXED);
+      op->b = decimal_zero();
+      break;
+  }
+}
+
+void s21_workload_trace(s21_workload *workload, s21_trace_op *ops, size_t n) {
+  for (size_t i = 0; ops && i < n; i++) {
+    unsigned int pick = next_below(workload, 100);
+    int op = 0;
+    while (op < S21_OP_COUNT - 1 && pick >= op_weights[op]) {
+      pick -= op_weights[op];
+      op++;
+    }
+    ops[i].op = (s21_trace_op_code)op;
+    fill_operands(workload, &ops[i]);
+  }
+}
+
+// Одна операция трассы
+static int replay_one(const s21_trace_op *op, s21_decimal *result) {
+  int status = CodeOK;
+  int number = 0;
+  float real = 0;
+  *result = decimal_zero();
+  switch (op->op) {
+    case S21_OP_ADD:
+      status = s21_add(op->a, op->b, result);
+      break;
+    case S21_OP_SUB:
+      status = s21_sub(op->a, op->b, result);
+      break;
+    case S21_OP_MUL:
+      status = s21_mul(op->a, op->b, result);
+      break;
+    case S21_OP_DIV:
+      status = s21_div(op->a, op->b, result);
+      break;
+    case S21_OP_IS_LESS:
+      result->bits[0] = s21_is_less(op->a, op->b);
+      break;
+    case S21_OP_IS_LESS_OR_EQUAL:
+      result->bits[0] = s21_is_less_or_equal(op->a, op->b);
+      break;
+    case S21_OP_IS_GREATER:
+      result->bits[0] = s21_is_greater(op->a, op->b);
+      break;
+    case S21_OP_IS_GREATER_OR_EQUAL:
+      result->bits[0] = s21_is_greater_or_equal(op->a, op->b);
+      break;
+    case S21_OP_IS_EQUAL:
+      result->bits[0] = s21_is_equal(op->a, op->b);
+      break;
+    case S21_OP_IS_NOT_EQUAL:
+      result->bits[0] = s21_is_not_equal(op->a, op->b);
+      break;
+    case S21_OP_FLOOR:
+      status = s21_floor(op->a, result);
+      break;
+    case S21_OP_ROUND:
+      status = s21_round(op->a, result);
+      break;
+    case S21_OP_TRUNCATE:
+      status = s21_truncate(op->a, result);
+      break;
+    case S21_OP_NEGATE:
+      status = s21_negate(op->a, result);
+      break;
+    case S21_OP_CEIL:
+      status = s21_ceil(op->a, result);
+      break;
+    case S21_OP_TO_INT:
+      status = s21_from_decimal_to_int(op->a, &number);
+      if (status == CodeOK) s21_from_int_to_decimal(number, result);
+      break;
+    case S21_OP_TO_FLOAT:
+      status = s21_from_decimal_to_float(op->a, &real);
+      if (status == CodeOK) status = s21_from_float_to_decimal(real, result);
+      break;
+    case S21_OP_RESCALE:
+      status = s21_rescale(op->a, 2, S21_ROUND_HALF_EVEN, result);
+      break;
+    default:
+      status = CodeInvalidData;
+      break;
+  }
+  return status;
+}
+
+int s21_trace_replay(const s21_trace_op *ops, size_t n, s21_decimal *results,
+                     int *codes) {
+  if (n > 0 && !ops) return CodeInvalidData;
+  int status = CodeOK;
+  for (size_t i = 0; i < n; i++) {
+    s21_decimal result;
+    int code = replay_one(&ops[i], &result);
+    if (results) results[i] = result;
+    if (codes) codes[i] = code;
+    if (status == CodeOK) status = code;
+  }
+  return status;
+}
+
+static const char *op_names[S21_OP_COUNT] = {
+    "add",        "sub",        "mul",        "div",        "less",
+    "less_eq",    "greater",    "greater_eq", "equal",      "not_equal",
+    "floor",      "round",      "truncate",   "negate",     "ceil",
+    "to_int",     "to_float",   "rescale",
+};
+
+const char *s21_trace_op_name(s21_trace_op_code op) {
+  return ((int)op >= 0 && op < S21_OP_COUNT) ? op_names[op] : "unknown";
+}
+
+int s21_trace_write(FILE *out, const s21_trace_op *ops, size_t n) {
+  if (!out || (n > 0 && !ops)) return CodeInvalidData;
+  int status = CodeOK;
+  for (size_t i = 0; i < n && status == CodeOK; i++) {
+    const s21_decimal *a = &ops[i].a;
+    const s21_decimal *b = &ops[i].b;
+    if (fprintf(out, "%s %08X %08X %08X %08X %08X %08X %08X %08X\n",
+                s21_trace_op_name(ops[i].op), a->bits[0], a->bits[1],
+                a->bits[2], a->bits[3], b->bits[0], b->bits[1], b->bits[2],
+                b->bits[3]) < 0) {
+      status = CodeInvalidData;
+    }
+  }
+  return status;
+}
+
+int s21_trace_read(FILE *in, s21_trace_op *ops, size_t capacity,
+                   size_t *count) {
+  if (!in || !count || (capacity > 0 && !ops)) return CodeInvalidData;
+  int status = CodeOK;
+  char line[256];
+  *count = 0;
+  while (status == CodeOK && *count < capacity &&
+         fgets(line, sizeof(line), in)) {
+    char name[32];
+    s21_trace_op op;
+    if (line[0] == '#' || line[0] == '\n') continue;
+    int fields = sscanf(line, "%31s %x %x %x %x %x %x %x %x", name,
+                        &op.a.bits[0], &op.a.bits[1], &op.a.bits[2],
+                        &op.a.bits[3], &op.b.bits[0], &op.b.bits[1],
+                        &op.b.bits[2], &op.b.bits[3]);
+    int code = 0;
+    while (code < S21_OP_COUNT && strcmp(op_names[code], name) != 0) code++;
+    if (fields != 9 || code == S21_OP_COUNT) {
+      status = CodeInvalidData;
+    } else {
+      op.op = (s21_trace_op_code)code;
+      ops[(*count)++] = op;
+    }
+  }
+  return status;
+}
@@ -1,7 +1,13 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <check.h>
+#include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "../src/s21_decimal.h"
+#include "../src/s21_decimal_inline.h"
 
 #define DEC(bits0, bits1, bits2, scale, sign)                 \
   (s21_decimal) {                                             \
@@ -1968,6 +1974,1821 @@ START_TEST(add_trigger_add_one_to_mantissa) {
 }
 END_TEST
 
+//////// Тесты для смешанной арифметики с целыми ////////
+// 1.25 + 3 = 4.25
+START_TEST(add_i64_scale) {
+  s21_decimal v = DEC(125, 0, 0, 2, 0);
+  s21_decimal res = {{0}};
+
+  int code = s21_add_i64(v, 3, &res);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(res.bits[0], 425);
+  ck_assert_int_eq(get_scale(res), 2);
+  ck_assert_int_eq(get_sign(res), 0);
+}
+END_TEST
+
+// 1.5 - INT64_MIN = 9223372036854775809.5
+START_TEST(sub_i64_min) {
+  s21_decimal v = DEC(15, 0, 0, 1, 0);
+  s21_decimal res = {{0}};
+
+  int code = s21_sub_i64(v, INT64_MIN, &res);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(res.bits[0], 0x0000000F);
+  ck_assert_uint_eq(res.bits[1], 0x00000000);
+  ck_assert_uint_eq(res.bits[2], 0x00000005);
+  ck_assert_int_eq(get_scale(res), 1);
+  ck_assert_int_eq(get_sign(res), 0);
+}
+END_TEST
+
+// Результат совпадает с s21_add, когда число не помещается в мантиссу
+START_TEST(add_i64_matches_add_on_overflow) {
+  s21_decimal v = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0x0FFFFFFF, 10, 1);
+  s21_decimal expected = {{0}};
+  s21_decimal res = {{0}};
+  s21_decimal number = {{0}};
+  s21_from_int_to_decimal(2000000000, &number);
+
+  int expected_code = s21_add(v, number, &expected);
+  int code = s21_add_i64(v, 2000000000, &res);
+
+  ck_assert_int_eq(code, expected_code);
+  for (int i = 0; i < 4; i++) ck_assert_uint_eq(res.bits[i], expected.bits[i]);
+}
+END_TEST
+
+// -0.003 * -7 = 0.021
+START_TEST(mul_i64_negative) {
+  s21_decimal v = DEC(3, 0, 0, 3, 1);
+  s21_decimal res = {{0}};
+
+  int code = s21_mul_i64(v, -7, &res);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(res.bits[0], 21);
+  ck_assert_int_eq(get_scale(res), 3);
+  ck_assert_int_eq(get_sign(res), 0);
+}
+END_TEST
+
+// MAX * 2 - переполнение
+START_TEST(mul_i64_overflow) {
+  s21_decimal v = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 1);
+  s21_decimal res = {{0}};
+
+  int code = s21_mul_i64(v, 2, &res);
+
+  ck_assert_int_eq(code, CodeSmallNumber);
+}
+END_TEST
+
+// 1 / 3 совпадает с s21_div
+START_TEST(div_i64_matches_div) {
+  s21_decimal v = DEC(1, 0, 0, 0, 0);
+  s21_decimal three = DEC(3, 0, 0, 0, 0);
+  s21_decimal expected = {{0}};
+  s21_decimal res = {{0}};
+
+  s21_div(v, three, &expected);
+  int code = s21_div_i64(v, 3, &res);
+
+  ck_assert_int_eq(code, CodeOK);
+  for (int i = 0; i < 4; i++) ck_assert_uint_eq(res.bits[i], expected.bits[i]);
+}
+END_TEST
+
+// 10 / -4 = -2.5; делитель шире 32 бит; деление на ноль
+START_TEST(div_i64_cases) {
+  s21_decimal v = DEC(10, 0, 0, 0, 0);
+  s21_decimal res = {{0}};
+
+  ck_assert_int_eq(s21_div_i64(v, -4, &res), CodeOK);
+  ck_assert_uint_eq(res.bits[0], 25);
+  ck_assert_int_eq(get_scale(res), 1);
+  ck_assert_int_eq(get_sign(res), 1);
+
+  s21_decimal big = DEC(0, 0, 1, 0, 0);  // 2^64
+  ck_assert_int_eq(s21_div_i64(big, 4294967296LL, &res), CodeOK);
+  ck_assert_uint_eq(res.bits[0], 0);
+  ck_assert_uint_eq(res.bits[1], 1);
+
+  ck_assert_int_eq(s21_div_i64(v, 0, &res), CodeDivisionZero);
+}
+END_TEST
+
+// Пакетная версия с кодами для каждого элемента
+START_TEST(mul_i64_batch) {
+  s21_decimal values[3] = {DEC(150, 0, 0, 2, 0), DEC(2, 0, 0, 0, 1),
+                           DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0)};
+  int64_t numbers[3] = {4, 5, 10};
+  s21_decimal res[3] = {{{0}}};
+  int codes[3] = {0};
+
+  int code = s21_mul_i64_n(values, numbers, res, codes, 3, NULL);
+
+  ck_assert_int_eq(code, CodeBigNumber);
+  ck_assert_int_eq(codes[0], CodeOK);
+  ck_assert_int_eq(codes[1], CodeOK);
+  ck_assert_int_eq(codes[2], CodeBigNumber);
+  ck_assert_uint_eq(res[0].bits[0], 600);
+  ck_assert_uint_eq(res[1].bits[0], 10);
+  ck_assert_int_eq(get_sign(res[1]), 1);
+}
+END_TEST
+
+//////// Тесты для s21_rescale и s21_ceil ////////
+// 2.345 -> 2.34 (к четному), 2.35 (от нуля), 2.34 (к нулю при 0.5)
+START_TEST(rescale_half_modes) {
+  s21_decimal v = DEC(2345, 0, 0, 3, 0);
+  s21_decimal res = {{0}};
+
+  ck_assert_int_eq(s21_rescale(v, 2, S21_ROUND_HALF_EVEN, &res), CodeOK);
+  ck_assert_uint_eq(res.bits[0], 234);
+  ck_assert_int_eq(get_scale(res), 2);
+  s21_rescale(v, 2, S21_ROUND_HALF_UP, &res);
+  ck_assert_uint_eq(res.bits[0], 235);
+  s21_rescale(v, 2, S21_ROUND_HALF_DOWN, &res);
+  ck_assert_uint_eq(res.bits[0], 234);
+  // Недопустимый входной scale, как у s21_quantize_n
+  s21_decimal bad = DEC(5, 0, 0, 29, 0);
+  ck_assert_int_eq(s21_rescale(bad, 2, S21_ROUND_HALF_EVEN, &res),
+                   CodeInvalidData);
+  bad.bits[3] = 0x00FF0000;
+  ck_assert_int_eq(s21_rescale(bad, 0, S21_ROUND_HALF_EVEN, &res),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_quantize_n(&bad, &res, 1, 0, S21_ROUND_HALF_EVEN,
+                                  NULL, NULL),
+                   CodeInvalidData);
+}
+END_TEST
+
+// -1.0000000000000000000001 -> -2 (floor), -1 (ceiling), -2 (от нуля)
+START_TEST(rescale_directed_modes) {
+  // 10^22 + 1 со scale 22
+  s21_decimal v = DEC(0xB2400001, 0x19E0C9BA, 0x0000021E, 22, 1);
+  s21_decimal res = {{0}};
+
+  s21_rescale(v, 0, S21_ROUND_FLOOR, &res);
+  ck_assert_uint_eq(res.bits[0], 2);
+  ck_assert_int_eq(get_sign(res), 1);
+  s21_rescale(v, 0, S21_ROUND_CEILING, &res);
+  ck_assert_uint_eq(res.bits[0], 1);
+  s21_rescale(v, 0, S21_ROUND_AWAY_FROM_ZERO, &res);
+  ck_assert_uint_eq(res.bits[0], 2);
+  s21_rescale(v, 0, S21_ROUND_TRUNCATE, &res);
+  ck_assert_uint_eq(res.bits[0], 1);
+  // Хвост после guard-цифры 0 не дает половины
+  s21_rescale(v, 0, S21_ROUND_HALF_UP, &res);
+  ck_assert_uint_eq(res.bits[0], 1);
+}
+END_TEST
+
+// Увеличение масштаба: 1.5 -> 1.500, переполнение при MAX
+START_TEST(rescale_up) {
+  s21_decimal v = DEC(15, 0, 0, 1, 0);
+  s21_decimal max = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 1);
+  s21_decimal res = {{0}};
+
+  ck_assert_int_eq(s21_rescale(v, 3, S21_ROUND_HALF_EVEN, &res), CodeOK);
+  ck_assert_uint_eq(res.bits[0], 1500);
+  ck_assert_int_eq(get_scale(res), 3);
+  ck_assert_int_eq(s21_rescale(max, 1, S21_ROUND_HALF_EVEN, &res),
+                   CodeSmallNumber);
+  ck_assert_int_eq(s21_rescale(v, 29, S21_ROUND_HALF_EVEN, &res),
+                   CodeInvalidData);
+}
+END_TEST
+
+// ceil: 2.1 -> 3, -2.9 -> -2, 5 -> 5
+START_TEST(ceil_cases) {
+  s21_decimal res = {{0}};
+
+  s21_ceil(DEC(21, 0, 0, 1, 0), &res);
+  ck_assert_uint_eq(res.bits[0], 3);
+  ck_assert_int_eq(get_sign(res), 0);
+  s21_ceil(DEC(29, 0, 0, 1, 1), &res);
+  ck_assert_uint_eq(res.bits[0], 2);
+  ck_assert_int_eq(get_sign(res), 1);
+  s21_ceil(DEC(5, 0, 0, 0, 0), &res);
+  ck_assert_uint_eq(res.bits[0], 5);
+  ck_assert_int_eq(get_scale(res), 0);
+  ck_assert_int_eq(s21_ceil(DEC(5, 0, 0, 0, 0), NULL), CodeInvalidData);
+}
+END_TEST
+
+//////// Тесты для s21_quantize_n ////////
+// Приведение к центам: 1.005 -> 1.00, 2.5 -> 2.50, -0.125 -> -0.12
+START_TEST(quantize_usd) {
+  s21_decimal in[3] = {DEC(1005, 0, 0, 3, 0), DEC(25, 0, 0, 1, 0),
+                       DEC(125, 0, 0, 3, 1)};
+  s21_decimal out[3] = {{{0}}};
+  int codes[3] = {-1, -1, -1};
+
+  int code = s21_quantize_n(in, out, 3, 2, S21_ROUND_HALF_EVEN, codes, NULL);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(out[0].bits[0], 100);
+  ck_assert_uint_eq(out[1].bits[0], 250);
+  ck_assert_uint_eq(out[2].bits[0], 12);
+  ck_assert_int_eq(get_sign(out[2]), 1);
+  for (int i = 0; i < 3; i++) {
+    ck_assert_int_eq(get_scale(out[i]), 2);
+    ck_assert_int_eq(codes[i], CodeOK);
+  }
+}
+END_TEST
+
+// Переполнение при увеличении масштаба отмечается для каждого элемента
+START_TEST(quantize_overflow) {
+  s21_decimal in[3] = {DEC(7, 0, 0, 0, 0),
+                       DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0),
+                       DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 1)};
+  s21_decimal out[3] = {{{0}}};
+  int codes[3] = {0};
+
+  int code = s21_quantize_n(in, out, 3, 3, S21_ROUND_HALF_EVEN, codes, NULL);
+
+  ck_assert_int_eq(code, CodeBigNumber);
+  ck_assert_int_eq(codes[0], CodeOK);
+  ck_assert_uint_eq(out[0].bits[0], 7000);
+  ck_assert_int_eq(codes[1], CodeBigNumber);
+  ck_assert_int_eq(codes[2], CodeSmallNumber);
+}
+END_TEST
+
+// Результат совпадает с s21_rescale для смешанных scale, в том числе на
+// месте (in == out)
+START_TEST(quantize_matches_rescale) {
+  s21_decimal in[300];
+  s21_decimal expected[300];
+  for (int i = 0; i < 300; i++) {
+    in[i] = DEC(0x9ABCDEF1u * (i + 1), i * 7919u, (i % 3) ? 0 : i, i % 29,
+                i % 2);
+    s21_rescale(in[i], 1, S21_ROUND_FLOOR, &expected[i]);
+  }
+
+  int code = s21_quantize_n(in, in, 300, 1, S21_ROUND_FLOOR, NULL, NULL);
+
+  ck_assert_int_eq(code, CodeOK);
+  for (int i = 0; i < 300; i++) {
+    for (int j = 0; j < 4; j++) {
+      ck_assert_uint_eq(in[i].bits[j], expected[i].bits[j]);
+    }
+  }
+}
+END_TEST
+
+//////// Тесты для s21_digit_count, s21_trailing_zeros и normalize ////////
+START_TEST(digit_count_cases) {
+  ck_assert_int_eq(s21_digit_count(DEC(0, 0, 0, 0, 0)), 1);
+  ck_assert_int_eq(s21_digit_count(DEC(9, 0, 0, 0, 0)), 1);
+  ck_assert_int_eq(s21_digit_count(DEC(10, 0, 0, 5, 1)), 2);
+  ck_assert_int_eq(s21_digit_count(DEC(999999999, 0, 0, 0, 0)), 9);
+  ck_assert_int_eq(s21_digit_count(DEC(1000000000, 0, 0, 0, 0)), 10);
+  // 10^28 - 1 и 10^28
+  ck_assert_int_eq(
+      s21_digit_count(DEC(0x0FFFFFFF, 0x3E250261, 0x204FCE5E, 0, 0)), 28);
+  ck_assert_int_eq(
+      s21_digit_count(DEC(0x10000000, 0x3E250261, 0x204FCE5E, 0, 0)), 29);
+  ck_assert_int_eq(
+      s21_digit_count(DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0)), 29);
+}
+END_TEST
+
+START_TEST(trailing_zeros_cases) {
+  ck_assert_int_eq(s21_trailing_zeros(DEC(0, 0, 0, 3, 0)), 0);
+  ck_assert_int_eq(s21_trailing_zeros(DEC(7, 0, 0, 0, 0)), 0);
+  ck_assert_int_eq(s21_trailing_zeros(DEC(1200, 0, 0, 0, 0)), 2);
+  ck_assert_int_eq(s21_trailing_zeros(DEC(1024, 0, 0, 0, 0)), 0);
+  // 10^28
+  ck_assert_int_eq(
+      s21_trailing_zeros(DEC(0x10000000, 0x3E250261, 0x204FCE5E, 0, 0)), 28);
+  // 3 * 10^19
+  ck_assert_int_eq(
+      s21_trailing_zeros(DEC(0x9DB80000, 0xA055690D, 0x00000001, 0, 0)), 19);
+}
+END_TEST
+
+// normalize убирает не больше scale нулей: 1200.00 -> 1200, 0.000 -> 0
+START_TEST(normalize_limits_by_scale) {
+  s21_decimal v = DEC(120000, 0, 0, 2, 1);
+  s21_decimal zero = DEC(0, 0, 0, 3, 0);
+
+  normalize(&v);
+  normalize(&zero);
+
+  ck_assert_uint_eq(v.bits[0], 1200);
+  ck_assert_int_eq(get_scale(v), 0);
+  ck_assert_int_eq(get_sign(v), 1);
+  ck_assert_int_eq(get_scale(zero), 0);
+}
+END_TEST
+
+// Выравнивание scale, когда меньший scale можно поднять лишь частично:
+// 8081893606.782379684 + 0.00000000000000000000946
+START_TEST(align_partial_raise) {
+  s21_decimal v1 = DEC(0x68C3A6A4, 0x7028A76A, 0, 9, 0);
+  s21_decimal v2 = DEC(946, 0, 0, 23, 0);
+  s21_decimal res = {{0}};
+
+  int code = s21_add(v2, v1, &res);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(res.bits[0], 0x6C256800);
+  ck_assert_uint_eq(res.bits[1], 0x504213C4);
+  ck_assert_uint_eq(res.bits[2], 0x1A1D2F8A);
+  ck_assert_int_eq(get_scale(res), 18);
+  ck_assert_int_eq(s21_is_greater(v1, v2), 1);
+}
+END_TEST
+
+//////// Тесты для s21_pow_int и s21_compound ////////
+START_TEST(pow_exact) {
+  s21_decimal result = {{0}};
+
+  int code = s21_pow_int(DEC(15, 0, 0, 1, 0), 2, &result);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(result.bits[0], 225);
+  ck_assert_int_eq(get_scale(result), 2);
+  ck_assert_int_eq(s21_pow_int(DEC(7, 0, 0, 0, 1), 0, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1);
+}
+END_TEST
+
+// 1.01^1000 = 20959.155637813660064441245788944... округляется один раз
+START_TEST(pow_long_chain) {
+  s21_decimal result = {{0}};
+
+  int code = s21_pow_int(DEC(101, 0, 0, 2, 0), 1000, &result);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0x12A5205D);
+  ck_assert_uint_eq(result.bits[1], 0xCC893A4A);
+  ck_assert_uint_eq(result.bits[2], 0x43B901D7);
+  ck_assert_int_eq(get_scale(result), 24);
+}
+END_TEST
+
+START_TEST(pow_negative_exponent) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_pow_int(DEC(2, 0, 0, 0, 0), -2, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 25);
+  ck_assert_int_eq(get_scale(result), 2);
+  // (-3)^-3 = -0.0370370370370370370370370370
+  ck_assert_int_eq(s21_pow_int(DEC(3, 0, 0, 0, 1), -3, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0xCFB425ED);
+  ck_assert_uint_eq(result.bits[1], 0xCD07B8E5);
+  ck_assert_uint_eq(result.bits[2], 0x001EA2E5);
+  ck_assert_int_eq(get_scale(result), 27);
+  ck_assert_int_eq(get_sign(result), 1);
+}
+END_TEST
+
+START_TEST(pow_errors) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_pow_int(DEC(0, 0, 0, 0, 0), -1, &result),
+                   CodeDivisionZero);
+  ck_assert_int_eq(s21_pow_int(DEC(10, 0, 0, 0, 0), 29, &result),
+                   CodeBigNumber);
+  ck_assert_int_eq(s21_pow_int(DEC(10, 0, 0, 0, 1), 29, &result),
+                   CodeSmallNumber);
+  ck_assert_int_eq(s21_pow_int(DEC(2, 0, 0, 0, 0), 3, NULL), CodeInvalidData);
+  // Крайние показатели: ответ решен задолго до конца, scale не переполняется
+  ck_assert_int_eq(s21_pow_int(DEC(10, 0, 0, 0, 0), INT_MAX, &result),
+                   CodeBigNumber);
+  ck_assert_int_eq(s21_pow_int(DEC(10, 0, 0, 0, 1), INT_MAX, &result),
+                   CodeSmallNumber);
+  ck_assert_int_eq(s21_pow_int(DEC(10, 0, 0, 0, 0), INT_MIN, &result),
+                   CodeOK);
+  ck_assert(s21_is_equal(result, DEC(0, 0, 0, 0, 0)));
+  ck_assert_int_eq(s21_pow_int(DEC(1, 0, 0, 1, 0), INT_MAX, &result),
+                   CodeOK);
+  ck_assert(s21_is_equal(result, DEC(0, 0, 0, 0, 0)));
+  ck_assert_int_eq(s21_pow_int(DEC(1, 0, 0, 1, 1), INT_MIN, &result),
+                   CodeBigNumber);
+  ck_assert_int_eq(s21_pow_int(DEC(1, 0, 0, 0, 1), INT_MIN, &result),
+                   CodeOK);
+  ck_assert(s21_is_equal(result, DEC(1, 0, 0, 0, 0)));
+}
+END_TEST
+
+START_TEST(compound_batch) {
+  s21_decimal principal[2] = {DEC(1000, 0, 0, 0, 0), DEC(1000, 0, 0, 0, 0)};
+  s21_decimal rate[2] = {DEC(5, 0, 0, 2, 0), DEC(5, 0, 0, 2, 0)};
+  int periods[2] = {2, -1};
+  s21_decimal out[2] = {{{0}}};
+  int codes[2] = {-1, -1};
+
+  int code = s21_compound_n(principal, rate, periods, out, codes, 2, NULL);
+
+  ck_assert_int_eq(code, CodeOK);
+  ck_assert_int_eq(codes[0], CodeOK);
+  ck_assert_int_eq(codes[1], CodeOK);
+  // 1102.5000
+  ck_assert_uint_eq(out[0].bits[0], 11025000);
+  ck_assert_int_eq(get_scale(out[0]), 4);
+  // 952.3809523809523809523809524
+  ck_assert_uint_eq(out[1].bits[0], 0x33CF3CF4);
+  ck_assert_uint_eq(out[1].bits[1], 0xCD78948D);
+  ck_assert_uint_eq(out[1].bits[2], 0x1EC5E91C);
+  ck_assert_int_eq(get_scale(out[1]), 25);
+}
+END_TEST
+
+//////// Тесты для s21_sqrt, s21_exp, s21_ln и s21_log10 ////////
+// Сравнение результата с ожидаемыми битами и scale
+static void check_bits(s21_decimal result, s21_decimal expected) {
+  for (int i = 0; i < 4; i++) {
+    ck_assert_uint_eq(result.bits[i], expected.bits[i]);
+  }
+}
+
+START_TEST(sqrt_cases) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_sqrt(DEC(225, 0, 0, 2, 0), &result), CodeOK);
+  check_bits(result, DEC(15, 0, 0, 1, 0));
+  ck_assert_int_eq(s21_sqrt(DEC(2, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0x5B611DCA, 0x5778CD49, 0x2DB219B4, 28, 0));
+  // sqrt(10^-28) = 10^-14
+  ck_assert_int_eq(s21_sqrt(DEC(1, 0, 0, 28, 0), &result), CodeOK);
+  check_bits(result, DEC(1, 0, 0, 14, 0));
+  ck_assert_int_eq(s21_sqrt(DEC(0, 0, 0, 3, 1), &result), CodeOK);
+  check_bits(result, DEC(0, 0, 0, 0, 0));
+  ck_assert_int_eq(s21_sqrt(DEC(4, 0, 0, 0, 1), &result), CodeInvalidData);
+}
+END_TEST
+
+START_TEST(exp_cases) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_exp(DEC(0, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(1, 0, 0, 0, 0));
+  ck_assert_int_eq(s21_exp(DEC(1, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0x857AED5A, 0xEBECDE35, 0x57D519AB, 28, 0));
+  ck_assert_int_eq(s21_exp(DEC(1, 0, 0, 0, 1), &result), CodeOK);
+  check_bits(result, DEC(0x8E19DB46, 0xAA58AC52, 0x0BE30704, 28, 0));
+  ck_assert_int_eq(s21_exp(DEC(66, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0xF0CA2FAC, 0xFE7C35D5, 0x94DDC12E, 0, 0));
+  ck_assert_int_eq(s21_exp(DEC(67, 0, 0, 0, 0), &result), CodeBigNumber);
+  ck_assert_int_eq(s21_exp(DEC(100, 0, 0, 0, 1), &result), CodeOK);
+  ck_assert_int_eq(is_zero(result), 1);
+}
+END_TEST
+
+START_TEST(ln_cases) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_ln(DEC(1, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0, 0, 0, 0, 0));
+  ck_assert_int_eq(s21_ln(DEC(10, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0x9FA69733, 0x1414B220, 0x4A668998, 28, 0));
+  ck_assert_int_eq(s21_ln(DEC(0, 0, 0, 0, 0), &result), CodeSmallNumber);
+  ck_assert_int_eq(s21_ln(DEC(5, 0, 0, 1, 1), &result), CodeInvalidData);
+}
+END_TEST
+
+START_TEST(log10_cases) {
+  s21_decimal result = {{0}};
+
+  ck_assert_int_eq(s21_log10(DEC(1000, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(3, 0, 0, 0, 0));
+  ck_assert_int_eq(s21_log10(DEC(1, 0, 0, 2, 0), &result), CodeOK);
+  check_bits(result, DEC(2, 0, 0, 0, 1));
+  ck_assert_int_eq(s21_log10(DEC(2, 0, 0, 0, 0), &result), CodeOK);
+  check_bits(result, DEC(0xC282C393, 0xA41ED093, 0x09BA0FCF, 28, 0));
+}
+END_TEST
+
+START_TEST(transcendental_batch) {
+  s21_decimal in[3] = {DEC(16, 0, 0, 0, 0), DEC(9, 0, 0, 0, 1),
+                       DEC(1, 0, 0, 2, 0)};
+  s21_decimal out[3] = {{{0}}};
+  int codes[3] = {0};
+
+  ck_assert_int_eq(s21_sqrt_n(in, out, codes, 3, NULL), CodeInvalidData);
+  ck_assert_int_eq(codes[0], CodeOK);
+  ck_assert_int_eq(codes[1], CodeInvalidData);
+  ck_assert_int_eq(codes[2], CodeOK);
+  check_bits(out[0], DEC(4, 0, 0, 0, 0));
+  check_bits(out[2], DEC(1, 0, 0, 1, 0));
+  ck_assert_int_eq(s21_log10_n(in, out, NULL, 1, NULL), CodeOK);
+  ck_assert_int_eq(s21_exp_n(NULL, out, NULL, 1, NULL), CodeInvalidData);
+  ck_assert_int_eq(s21_ln_n(NULL, NULL, NULL, 0, NULL), CodeOK);
+}
+END_TEST
+
+//////// Тесты для генератора нагрузки ////////
+// Один seed - один поток значений
+START_TEST(workload_deterministic) {
+  s21_workload first;
+  s21_workload second;
+  s21_decimal a[64];
+  s21_decimal b[64];
+  s21_workload_init(&first, 7);
+  s21_workload_init(&second, 7);
+
+  s21_workload_fill(&first, S21_WORKLOAD_MIXED, a, 64);
+  s21_workload_fill(&second, S21_WORKLOAD_MIXED, b, 64);
+
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 4; j++) ck_assert_uint_eq(a[i].bits[j], b[i].bits[j]);
+  }
+}
+END_TEST
+
+START_TEST(workload_kinds) {
+  s21_workload workload;
+  s21_workload_init(&workload, 1);
+  for (int i = 0; i < 200; i++) {
+    s21_decimal price = s21_workload_next(&workload, S21_WORKLOAD_PRICE);
+    s21_decimal quantity = s21_workload_next(&workload, S21_WORKLOAD_QUANTITY);
+    s21_decimal rate = s21_workload_next(&workload, S21_WORKLOAD_FX_RATE);
+    s21_decimal pnl = s21_workload_next(&workload, S21_WORKLOAD_PNL);
+
+    ck_assert_int_eq(get_sign(price), 0);
+    ck_assert(get_scale(price) == 0 || get_scale(price) == 2 ||
+              get_scale(price) == 4);
+    ck_assert_int_eq(get_scale(quantity), 0);
+    ck_assert_uint_gt(quantity.bits[0], 0);
+    ck_assert_int_ge(get_scale(rate), 5);
+    ck_assert_int_le(get_scale(rate), 8);
+    ck_assert_int_eq(get_scale(pnl), 2);
+  }
+}
+END_TEST
+
+// Трасса записывается и читается без потерь, прогон дает те же коды
+START_TEST(workload_trace_roundtrip) {
+  s21_workload workload;
+  s21_trace_op ops[100];
+  s21_trace_op loaded[100];
+  int codes[100];
+  int loaded_codes[100];
+  size_t count = 0;
+  s21_workload_init(&workload, 3);
+  s21_workload_trace(&workload, ops, 100);
+  FILE *file = tmpfile();
+  ck_assert_ptr_nonnull(file);
+
+  ck_assert_int_eq(s21_trace_write(file, ops, 100), CodeOK);
+  rewind(file);
+  ck_assert_int_eq(s21_trace_read(file, loaded, 100, &count), CodeOK);
+  fclose(file);
+
+  ck_assert_uint_eq(count, 100);
+  s21_trace_replay(ops, 100, NULL, codes);
+  s21_trace_replay(loaded, 100, NULL, loaded_codes);
+  for (int i = 0; i < 100; i++) {
+    ck_assert_int_eq(loaded[i].op, ops[i].op);
+    ck_assert_int_eq(loaded_codes[i], codes[i]);
+  }
+}
+END_TEST
+
+START_TEST(workload_replay_results) {
+  s21_trace_op ops[2] = {
+      {S21_OP_MUL, DEC(150, 0, 0, 2, 0), DEC(4, 0, 0, 0, 0)},
+      {S21_OP_IS_LESS, DEC(1, 0, 0, 0, 0), DEC(2, 0, 0, 0, 0)}};
+  s21_decimal results[2];
+  int codes[2];
+
+  ck_assert_int_eq(s21_trace_replay(ops, 2, results, codes), CodeOK);
+  ck_assert_uint_eq(results[0].bits[0], 600);
+  ck_assert_int_eq(get_scale(results[0]), 2);
+  ck_assert_uint_eq(results[1].bits[0], 1);
+  ck_assert_str_eq(s21_trace_op_name(S21_OP_RESCALE), "rescale");
+  ck_assert_int_eq(s21_trace_replay(NULL, 1, NULL, NULL), CodeInvalidData);
+}
+END_TEST
+
+START_TEST(stats_names) {
+  ck_assert_str_eq(s21_stats_name(S21_STAT_ALIGN_LOSSY), "align_lossy");
+  ck_assert_str_eq(s21_stats_name(S21_STAT_FAST_QUANTIZE_64),
+                   "fast_quantize_64");
+  ck_assert_str_eq(s21_stats_name(S21_STAT_COUNT), "unknown");
+}
+END_TEST
+
+START_TEST(stats_slow_paths) {
+  s21_decimal max = {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0}};
+  s21_decimal small = {{1, 0, 0, 28 << 16}};
+  s21_decimal one = {{1, 0, 0, 0}};
+  s21_decimal three = {{3, 0, 0, 0}};
+  s21_decimal result;
+  s21_stats stats;
+
+  s21_stats_reset();
+  ck_assert_int_eq(s21_add(max, small, &result), CodeOK);
+  ck_assert_int_eq(s21_mul(max, max, &result), CodeBigNumber);
+  ck_assert_int_eq(s21_div(one, three, &result), CodeOK);
+  ck_assert_int_eq(s21_add_i64(one, 5, &result), CodeOK);
+  s21_stats_snapshot(&stats);
+
+  if (stats.enabled) {
+    // max не поднимается ни на разряд: отбрасываются все 28 цифр small
+    ck_assert_uint_eq(stats.counters[S21_STAT_ALIGN_LOSSY], 1);
+    ck_assert_uint_eq(stats.counters[S21_STAT_ALIGN_LOSSY_DIGITS], 28);
+    ck_assert_uint_eq(stats.counters[S21_STAT_MUL_NORMALIZE], 1);
+    ck_assert_uint_eq(stats.counters[S21_STAT_OVERFLOW], 1);
+    ck_assert_uint_eq(stats.counters[S21_STAT_DIV_FRACTIONAL], 1);
+    ck_assert_uint_eq(stats.counters[S21_STAT_DIV_FRACTIONAL_DIGITS], 28);
+    ck_assert_uint_eq(stats.counters[S21_STAT_FAST_ADD_I64], 1);
+  } else {
+    for (int i = 0; i < S21_STAT_COUNT; i++) {
+      ck_assert_uint_eq(stats.counters[i], 0);
+    }
+  }
+}
+END_TEST
+
+START_TEST(stats_reset_clears) {
+  s21_decimal a = {{15, 0, 0, 1 << 16}};
+  s21_decimal b = {{2, 0, 0, 1 << 16}};
+  s21_decimal result;
+  s21_stats stats;
+
+  ck_assert_int_eq(s21_add(a, b, &result), CodeOK);
+  s21_stats_reset();
+  s21_stats_snapshot(&stats);
+  for (int i = 0; i < S21_STAT_COUNT; i++) {
+    ck_assert_uint_eq(stats.counters[i], 0);
+  }
+  ck_assert_int_eq(s21_add(a, b, &result), CodeOK);
+  s21_stats_snapshot(&stats);
+  ck_assert_uint_eq(stats.counters[S21_STAT_ALIGN_SAME_SCALE],
+                    stats.enabled ? 1 : 0);
+}
+END_TEST
+
+START_TEST(latency_percentiles) {
+  s21_latency_histogram histogram = {{0}, 0, 0, 0, 0};
+  // Корзины 16 на степень двойки: 5 - точная, 640..671 - одна корзина
+  histogram.counts[5] = 50;
+  histogram.counts[100] = 50;
+  histogram.total = 100;
+  histogram.min = 5;
+  histogram.max = 700;
+  ck_assert_uint_eq(s21_latency_percentile(&histogram, 0), 5);
+  ck_assert_uint_eq(s21_latency_percentile(&histogram, 50), 5);
+  ck_assert_uint_eq(s21_latency_percentile(&histogram, 90), 671);
+  ck_assert_uint_eq(s21_latency_percentile(&histogram, 100), 671);
+  histogram.max = 650;
+  ck_assert_uint_eq(s21_latency_percentile(&histogram, 99), 650);
+  ck_assert_uint_eq(s21_latency_percentile(NULL, 50), 0);
+}
+END_TEST
+
+START_TEST(latency_names) {
+  ck_assert_str_eq(s21_latency_op_name(S21_LAT_ADD), "s21_add");
+  ck_assert_str_eq(s21_latency_op_name(S21_LAT_TO_FLOAT),
+                   "s21_from_decimal_to_float");
+  ck_assert_str_eq(s21_latency_op_name(S21_LAT_COUNT), "unknown");
+}
+END_TEST
+
+START_TEST(latency_sampling) {
+  s21_decimal a = {{15, 0, 0, 1 << 16}};
+  s21_decimal b = {{2, 0, 0, 0}};
+  s21_decimal result;
+  s21_latency_histogram histogram;
+  int enabled = (*s21_latency_unit() != '\0');
+
+  s21_latency_set_rate(1);
+  s21_latency_reset();
+  for (int i = 0; i < 10; i++) s21_add(a, b, &result);
+  s21_mul(a, b, &result);
+  ck_assert_int_eq(s21_latency_merge(S21_LAT_ADD, &histogram), CodeOK);
+  ck_assert_uint_eq(histogram.total, enabled ? 10 : 0);
+  ck_assert_int_eq(s21_latency_merge(S21_LAT_MUL, &histogram), CodeOK);
+  ck_assert_uint_eq(histogram.total, enabled ? 1 : 0);
+  ck_assert_int_eq(s21_latency_merge(S21_LAT_COUNT, &histogram),
+                   CodeInvalidData);
+
+  FILE *out = tmpfile();
+  char text[4096] = {0};
+  ck_assert_ptr_nonnull(out);
+  ck_assert_int_eq(s21_latency_dump(out, S21_LATENCY_JSON), CodeOK);
+  rewind(out);
+  size_t length = fread(text, 1, sizeof(text) - 1, out);
+  fclose(out);
+  ck_assert_uint_gt(length, 0);
+  ck_assert_int_eq(strstr(text, "\"function\": \"s21_add\"") != NULL, enabled);
+  s21_latency_set_rate(S21_LATENCY_RATE);
+}
+END_TEST
+
+START_TEST(inline_matches_extern) {
+  s21_decimal values[4] = {
+      {{0, 0, 0, 0}},
+      {{0x80000001, 0, 0x40000000, (28u << 16) | 0x80000000u}},
+      {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 3u << 16}},
+      {{5, 7, 0, 0x80000000u}},
+  };
+  for (int i = 0; i < 4; i++) {
+    ck_assert_int_eq(is_zero(values[i]), (is_zero)(values[i]));
+    ck_assert_int_eq(get_sign(values[i]), (get_sign)(values[i]));
+    ck_assert_int_eq(get_scale(values[i]), (get_scale)(values[i]));
+    for (int bit = 0; bit < 96; bit += 7) {
+      ck_assert_int_eq(get_bit(values[i], bit), (get_bit)(values[i], bit));
+    }
+    for (int j = 0; j < 4; j++) {
+      ck_assert_int_eq(compare_magnitude(values[i], values[j]),
+                       (compare_magnitude)(values[i], values[j]));
+    }
+  }
+}
+END_TEST
+
+START_TEST(inline_setters_match_extern) {
+  s21_decimal a = {{1, 2, 3, 0}};
+  s21_decimal b = a;
+  set_bit(&a, 95, 1);
+  (set_bit)(&b, 95, 1);
+  set_bit(&a, 0, 0);
+  (set_bit)(&b, 0, 0);
+  set_sign(&a, 1);
+  (set_sign)(&b, 1);
+  set_scale(&a, 17);
+  (set_scale)(&b, 17);
+  // Недопустимый scale игнорируется обеими версиями
+  set_scale(&a, 29);
+  (set_scale)(&b, 29);
+  for (int i = 0; i < 4; i++) ck_assert_uint_eq(a.bits[i], b.bits[i]);
+  ck_assert_uint_eq(a.bits[3], (17u << 16) | 0x80000000u);
+  ck_assert_uint_eq(a.bits[2], 0x80000003u);
+}
+END_TEST
+
+START_TEST(ref_matches_by_value) {
+  s21_decimal a = {{123456789, 0, 0, 3u << 16}};
+  s21_decimal b = {{987, 0, 0, (1u << 16) | 0x80000000u}};
+  s21_decimal expected;
+  s21_decimal result;
+  ck_assert_int_eq(s21_add(a, b, &expected), s21_add_ref(&a, &b, &result));
+  ck_assert_int_eq(s21_is_equal(expected, result), 1);
+  ck_assert_int_eq(s21_sub(a, b, &expected), s21_sub_ref(&a, &b, &result));
+  ck_assert_int_eq(s21_is_equal(expected, result), 1);
+  ck_assert_int_eq(s21_mul(a, b, &expected), s21_mul_ref(&a, &b, &result));
+  ck_assert_int_eq(s21_is_equal(expected, result), 1);
+  ck_assert_int_eq(s21_div(a, b, &expected), s21_div_ref(&a, &b, &result));
+  ck_assert_int_eq(s21_is_equal(expected, result), 1);
+
+  // Результат на месте первого входа
+  result = a;
+  ck_assert_int_eq(s21_mul_ref(&result, &b, &result), CodeOK);
+  ck_assert_int_eq(s21_mul(a, b, &expected), CodeOK);
+  ck_assert_int_eq(s21_is_equal(expected, result), 1);
+
+  ck_assert_int_eq(s21_add_ref(NULL, &b, &result), CodeInvalidData);
+  ck_assert_int_eq(s21_sub_ref(&a, NULL, &result), CodeInvalidData);
+  ck_assert_int_eq(s21_div_ref(&a, &b, NULL), CodeInvalidData);
+}
+END_TEST
+
+START_TEST(assign_accumulates) {
+  s21_decimal acc = {{0}};
+  s21_decimal step = {{25, 0, 0, 2u << 16}};  // 0.25
+  for (int i = 0; i < 10; i++) {
+    ck_assert_int_eq(s21_add_assign(&acc, &step), CodeOK);
+  }
+  s21_decimal expected = {{250, 0, 0, 2u << 16}};
+  ck_assert_int_eq(s21_is_equal(acc, expected), 1);
+
+  s21_decimal two = {{2, 0, 0, 0}};
+  ck_assert_int_eq(s21_mul_assign(&acc, &two), CodeOK);
+  ck_assert_int_eq(s21_sub_assign(&acc, &step), CodeOK);
+  ck_assert_int_eq(s21_div_assign(&acc, &two), CodeOK);
+  expected = (s21_decimal){{2375, 0, 0, 3u << 16}};  // (5 - 0.25) / 2
+  ck_assert_int_eq(s21_is_equal(acc, expected), 1);
+}
+END_TEST
+
+START_TEST(assign_keeps_acc_on_error) {
+  s21_decimal max = {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0}};
+  s21_decimal acc = max;
+  s21_decimal zero = {{0}};
+  ck_assert_int_eq(s21_add_assign(&acc, &max), CodeBigNumber);
+  ck_assert_int_eq(s21_is_equal(acc, max), 1);
+  ck_assert_int_eq(s21_div_assign(&acc, &zero), CodeDivisionZero);
+  ck_assert_int_eq(s21_is_equal(acc, max), 1);
+  ck_assert_int_eq(s21_add_assign(NULL, &max), CodeInvalidData);
+  ck_assert_int_eq(s21_add_assign(&acc, NULL), CodeInvalidData);
+}
+END_TEST
+
+//////// Тесты для s21_atomic_decimal ////////
+START_TEST(atomic_single_thread) {
+  s21_atomic_decimal total;
+  s21_atomic_init(&total, DEC(150, 0, 0, 2, 0));
+  ck_assert_int_eq(s21_atomic_add(&total, DEC(25, 0, 0, 2, 0)), CodeOK);
+  ck_assert_int_eq(s21_atomic_add(&total, DEC(5, 0, 0, 3, 1)), CodeOK);
+  s21_decimal value = s21_atomic_load(&total);
+  ck_assert_int_eq(s21_is_equal(value, DEC(1745, 0, 0, 3, 0)), 1);
+
+  s21_decimal previous = s21_atomic_exchange(&total, DEC(7, 0, 0, 0, 0));
+  ck_assert_int_eq(s21_is_equal(previous, value), 1);
+  s21_atomic_store(&total, DEC(9, 0, 0, 1, 1));
+  value = s21_atomic_load(&total);
+  ck_assert_uint_eq(value.bits[0], 9);
+  ck_assert_uint_eq(value.bits[3], (1u << 16) | (1u << 31));
+}
+END_TEST
+
+// При ошибке итог не меняется, а смешанные scale дают то же, что s21_add
+START_TEST(atomic_matches_add) {
+  s21_decimal max = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0);
+  s21_atomic_decimal total;
+  s21_atomic_init(&total, max);
+  ck_assert_int_eq(s21_atomic_add(&total, max), CodeBigNumber);
+  s21_decimal value = s21_atomic_load(&total);
+  ck_assert_int_eq(memcmp(&value, &max, sizeof(max)), 0);
+
+  s21_decimal a = DEC(123456789, 0, 0, 5, 0);
+  s21_decimal b = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0x0FFFFFFF, 0, 1);
+  s21_decimal expected = {{0}};
+  int code = s21_add(a, b, &expected);
+  s21_atomic_init(&total, a);
+  ck_assert_int_eq(s21_atomic_add(&total, b), code);
+  value = s21_atomic_load(&total);
+  ck_assert_int_eq(memcmp(&value, &expected, sizeof(expected)), 0);
+}
+END_TEST
+
+static void *atomic_add_cents(void *argument) {
+  for (int i = 0; i < 1000; i++) {
+    s21_atomic_add(argument, DEC(1, 0, 0, 2, 0));
+  }
+  return NULL;
+}
+
+// 4 потока по 1000 раз прибавляют 0.01: ни одно сложение не теряется
+START_TEST(atomic_threads_exact) {
+  s21_atomic_decimal total;
+  s21_atomic_init(&total, DEC(0, 0, 0, 2, 0));
+  pthread_t threads[4];
+  for (int t = 0; t < 4; t++) {
+    ck_assert_int_eq(
+        pthread_create(&threads[t], NULL, atomic_add_cents, &total), 0);
+  }
+  for (int t = 0; t < 4; t++) pthread_join(threads[t], NULL);
+  s21_decimal value = s21_atomic_load(&total);
+  ck_assert_int_eq(s21_is_equal(value, DEC(4000, 0, 0, 2, 0)), 1);
+}
+END_TEST
+
+//////// Тесты для s21_sharded_sum ////////
+// 5e28 и десять раз по 0.4: s21_add теряет каждое 0.4, а шардированная
+// сумма округляет один раз и при любом числе слотов дает 5e28 + 4
+START_TEST(sharded_single_rounding) {
+  s21_decimal big = DEC(1342177280, 918096869, 2710505431, 0, 0);
+  s21_decimal expected = DEC(1342177284, 918096869, 2710505431, 0, 0);
+  for (size_t shards = 1; shards <= 4; shards++) {
+    s21_sharded_sum sum;
+    ck_assert_int_eq(s21_sharded_init(&sum, shards), CodeOK);
+    ck_assert_int_eq(s21_sharded_add(&sum, 0, big), CodeOK);
+    for (int i = 0; i < 10; i++) {
+      s21_sharded_add(&sum, (size_t)i % shards, DEC(4, 0, 0, 1, 0));
+    }
+    s21_decimal result = {{0}};
+    ck_assert_int_eq(s21_sharded_read(&sum, S21_ROUND_HALF_EVEN, &result),
+                     CodeOK);
+    ck_assert_int_eq(memcmp(&result, &expected, sizeof(result)), 0);
+    s21_sharded_free(&sum);
+  }
+}
+END_TEST
+
+START_TEST(sharded_errors_and_reset) {
+  s21_sharded_sum sum;
+  s21_decimal result = {{0}};
+  ck_assert_int_eq(s21_sharded_init(&sum, 0), CodeInvalidData);
+  ck_assert_int_eq(s21_sharded_init(&sum, 2), CodeOK);
+  ck_assert_int_eq(s21_sharded_add(&sum, 2, DEC(1, 0, 0, 0, 0)),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_sharded_add(&sum, 1, DEC(15, 0, 0, 1, 1)), CodeOK);
+  ck_assert_int_eq(s21_sharded_add(&sum, 0, DEC(1, 0, 0, 0, 0)), CodeOK);
+  s21_sharded_read(&sum, S21_ROUND_HALF_EVEN, &result);
+  ck_assert_int_eq(s21_is_equal(result, DEC(5, 0, 0, 1, 1)), 1);
+  s21_sharded_reset(&sum);
+  s21_sharded_read(&sum, S21_ROUND_HALF_EVEN, &result);
+  ck_assert_int_eq(s21_is_equal(result, DEC(0, 0, 0, 0, 0)), 1);
+  ck_assert_int_eq(s21_sharded_read(NULL, S21_ROUND_HALF_EVEN, &result),
+                   CodeInvalidData);
+  s21_sharded_free(&sum);
+}
+END_TEST
+
+typedef struct {
+  s21_sharded_sum *sum;
+  size_t shard;
+} sharded_worker;
+
+static void *sharded_add_cents(void *argument) {
+  sharded_worker *worker = argument;
+  for (int i = 0; i < 1000; i++) {
+    s21_sharded_add(worker->sum, worker->shard, DEC(1, 0, 0, 2, 0));
+  }
+  return NULL;
+}
+
+// 4 потока пишут каждый в свой слот, итог читается после завершения
+START_TEST(sharded_threads_exact) {
+  s21_sharded_sum sum;
+  ck_assert_int_eq(s21_sharded_init(&sum, 4), CodeOK);
+  pthread_t threads[4];
+  sharded_worker workers[4];
+  for (int t = 0; t < 4; t++) {
+    workers[t].sum = &sum;
+    workers[t].shard = (size_t)t;
+    ck_assert_int_eq(
+        pthread_create(&threads[t], NULL, sharded_add_cents, &workers[t]), 0);
+  }
+  for (int t = 0; t < 4; t++) pthread_join(threads[t], NULL);
+  s21_decimal result = {{0}};
+  s21_sharded_read(&sum, S21_ROUND_HALF_EVEN, &result);
+  ck_assert_int_eq(s21_is_equal(result, DEC(4000, 0, 0, 2, 0)), 1);
+  s21_sharded_free(&sum);
+}
+END_TEST
+
+//////// Тесты для пула потоков и параллельных сверток ////////
+static void pool_mark(void *context, size_t begin, size_t end) {
+  int *marks = context;
+  for (size_t i = begin; i < end; i++) {
+    __atomic_add_fetch(&marks[i], 1, __ATOMIC_RELAXED);
+  }
+}
+
+// Каждый элемент обрабатывается ровно один раз при любой политике, в том
+// числе когда блоков больше, чем участников, и их приходится красть
+START_TEST(exec_for_covers_each_index_once) {
+  int marks[1000];
+  s21_pool *pool = s21_pool_create(3);
+  ck_assert_ptr_nonnull(pool);
+  s21_exec_policy policies[4] = {{S21_EXEC_SEQUENTIAL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 4, NULL},
+                                 {S21_EXEC_POOL, 0, pool}};
+  for (int p = 0; p < 4; p++) {
+    for (size_t grain = 1; grain <= 300; grain *= 7) {
+      memset(marks, 0, sizeof(marks));
+      ck_assert_int_eq(
+          s21_exec_for(&policies[p], 1000, grain, pool_mark, marks), CodeOK);
+      for (int i = 0; i < 1000; i++) ck_assert_int_eq(marks[i], 1);
+    }
+  }
+  s21_exec_policy no_pool = {S21_EXEC_POOL, 0, NULL};
+  ck_assert_int_eq(s21_exec_for(&no_pool, 1, 1, pool_mark, marks),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_exec_for(NULL, 1, 1, NULL, marks), CodeInvalidData);
+  ck_assert_uint_eq(s21_exec_grain(S21_COST_ADD),
+                    S21_EXEC_CHUNK_NS / S21_COST_ADD);
+  ck_assert_uint_eq(s21_exec_grain(1000000), 1);
+  s21_pool_destroy(pool);
+  s21_pool_shutdown();
+}
+END_TEST
+
+// Пакет на 4 потоках дает те же значения и коды, что и последовательный, а
+// возвращаемый код - это код первой по индексу ошибки
+START_TEST(batch_parallel_matches_sequential) {
+  enum { COUNT = 5000 };
+  static s21_decimal values[COUNT];
+  static s21_decimal expected[COUNT];
+  static s21_decimal result[COUNT];
+  static int64_t numbers[COUNT];
+  static int expected_codes[COUNT];
+  static int codes[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 11);
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, values, COUNT);
+  for (int i = 0; i < COUNT; i++) numbers[i] = (i % 97) - 3;
+  s21_exec_policy parallel = {S21_EXEC_PARALLEL, 4, NULL};
+  int status =
+      s21_div_i64_n(values, numbers, expected, expected_codes, COUNT, NULL);
+  ck_assert_int_eq(status, CodeDivisionZero);
+  ck_assert_int_eq(
+      s21_div_i64_n(values, numbers, result, codes, COUNT, &parallel),
+      status);
+  ck_assert_int_eq(memcmp(result, expected, sizeof(result)), 0);
+  ck_assert_int_eq(memcmp(codes, expected_codes, sizeof(codes)), 0);
+
+  status = s21_quantize_n(values, expected, COUNT, 2, S21_ROUND_HALF_UP,
+                          expected_codes, NULL);
+  ck_assert_int_eq(s21_quantize_n(values, result, COUNT, 2,
+                                  S21_ROUND_HALF_UP, codes, &parallel),
+                   status);
+  ck_assert_int_eq(memcmp(result, expected, sizeof(result)), 0);
+  ck_assert_int_eq(memcmp(codes, expected_codes, sizeof(codes)), 0);
+  s21_pool_shutdown();
+}
+END_TEST
+
+// Итог и код побитно одинаковы на 1-8 потоках и совпадают с точной
+// цепочкой s21_add (у P&L один scale, округлений нет)
+START_TEST(reduce_sum_independent_of_threads) {
+  static s21_decimal values[50000];
+  s21_workload workload;
+  s21_workload_init(&workload, 7);
+  s21_workload_fill(&workload, S21_WORKLOAD_PNL, values, 50000);
+  s21_decimal chain = {{0}};
+  for (int i = 0; i < 50000; i++) s21_add(chain, values[i], &chain);
+  for (int threads = 1; threads <= 8; threads++) {
+    s21_decimal sum = {{0}};
+    s21_exec_policy policy = {S21_EXEC_PARALLEL, threads, NULL};
+    ck_assert_int_eq(s21_reduce_sum_parallel(values, 50000, &policy, &sum),
+                     CodeOK);
+    ck_assert_int_eq(memcmp(&sum, &chain, sizeof(sum)), 0);
+  }
+  s21_pool_shutdown();
+}
+END_TEST
+
+// 5e28 и десять раз по 0.4: одно округление в конце дает 5e28 + 4
+START_TEST(reduce_sum_single_rounding) {
+  s21_decimal values[11];
+  values[0] = DEC(1342177280, 918096869, 2710505431, 0, 0);
+  for (int i = 1; i < 11; i++) values[i] = DEC(4, 0, 0, 1, 0);
+  s21_decimal expected = DEC(1342177284, 918096869, 2710505431, 0, 0);
+  s21_decimal sum = {{0}};
+  s21_exec_policy policy = {S21_EXEC_PARALLEL, 2, NULL};
+  ck_assert_int_eq(s21_reduce_sum_parallel(values, 11, &policy, &sum), CodeOK);
+  ck_assert_int_eq(memcmp(&sum, &expected, sizeof(sum)), 0);
+
+  ck_assert_int_eq(s21_reduce_sum_parallel(NULL, 0, NULL, &sum), CodeOK);
+  ck_assert_int_eq(s21_is_equal(sum, DEC(0, 0, 0, 0, 0)), 1);
+  s21_decimal max = DEC(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0);
+  s21_decimal pair[2] = {max, max};
+  ck_assert_int_eq(s21_reduce_sum_parallel(pair, 2, NULL, &sum), CodeBigNumber);
+}
+END_TEST
+
+START_TEST(reduce_min_max_dot) {
+  s21_decimal values[5] = {DEC(10, 0, 0, 1, 0), DEC(3, 0, 0, 0, 1),
+                           DEC(100, 0, 0, 2, 0), DEC(30, 0, 0, 1, 1),
+                           DEC(7, 0, 0, 0, 0)};
+  s21_decimal result = {{0}};
+  s21_exec_policy policy = {S21_EXEC_PARALLEL, 2, NULL};
+  // Из равных -3 и -3.0 берется первый
+  ck_assert_int_eq(s21_reduce_min_parallel(values, 5, &policy, &result),
+                   CodeOK);
+  ck_assert_uint_eq(result.bits[0], 3);
+  ck_assert_uint_eq(result.bits[3], 1u << 31);
+  ck_assert_int_eq(s21_reduce_max_parallel(values, 5, &policy, &result),
+                   CodeOK);
+  ck_assert_uint_eq(result.bits[0], 7);
+  ck_assert_int_eq(s21_reduce_min_parallel(values, 0, &policy, &result),
+                   CodeInvalidData);
+
+  // Значения с недопустимым scale не сравниваются, а отклоняются, как и
+  // в сумме; result не меняется
+  s21_decimal invalid[3] = {DEC(5, 0, 0, 29, 0), DEC(1, 0, 0, 0, 0),
+                            DEC(7, 0, 0, 0xFF, 0)};
+  for (int i = 0; i < 2; i++) {
+    s21_decimal *bad = (i == 0) ? &invalid[0] : &invalid[2];
+    s21_decimal checked[2] = {invalid[1], *bad};
+    result = DEC(42, 0, 0, 0, 0);
+    ck_assert_int_eq(s21_reduce_min_parallel(checked, 2, &policy, &result),
+                     CodeInvalidData);
+    ck_assert_int_eq(s21_reduce_max_parallel(checked, 2, &policy, &result),
+                     CodeInvalidData);
+    ck_assert_uint_eq(result.bits[0], 42);
+  }
+  ck_assert_int_eq(s21_reduce_min_parallel(invalid, 3, &policy, &result),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_reduce_sum_parallel(invalid, 3, &policy, &result),
+                   CodeInvalidData);
+  // Ошибка в третьем блоке из трех
+  static s21_decimal many[40000];
+  for (int i = 0; i < 40000; i++) many[i] = DEC((unsigned int)i, 0, 0, 0, 0);
+  many[39999] = invalid[0];
+  ck_assert_int_eq(s21_reduce_max_parallel(many, 40000, &policy, &result),
+                   CodeInvalidData);
+  many[39999] = DEC(39999, 0, 0, 0, 0);
+  ck_assert_int_eq(s21_reduce_max_parallel(many, 40000, &policy, &result),
+                   CodeOK);
+  ck_assert_uint_eq(result.bits[0], 39999);
+
+  // 1.5 * 2 + (-2) * 0.25 = 2.5
+  s21_decimal a[2] = {DEC(15, 0, 0, 1, 0), DEC(2, 0, 0, 0, 1)};
+  s21_decimal b[2] = {DEC(2, 0, 0, 0, 0), DEC(25, 0, 0, 2, 0)};
+  ck_assert_int_eq(s21_reduce_dot_parallel(a, b, 2, &policy, &result), CodeOK);
+  ck_assert_int_eq(s21_is_equal(result, DEC(25, 0, 0, 1, 0)), 1);
+}
+END_TEST
+
+// Нарастающая сумма совпадает с цепочкой s21_add (P&L со scale 2 не
+// округляется) при любой политике, включая несколько блоков скана
+START_TEST(prefix_sum_matches_add_chain) {
+  enum { COUNT = 40000 };
+  static s21_decimal values[COUNT];
+  static s21_decimal expected[COUNT];
+  static s21_decimal result[COUNT];
+  static int codes[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 5);
+  s21_workload_fill(&workload, S21_WORKLOAD_PNL, values, COUNT);
+  s21_decimal sum = {{0}};
+  for (int i = 0; i < COUNT; i++) {
+    ck_assert_int_eq(s21_add(sum, values[i], &sum), CodeOK);
+    expected[i] = sum;
+  }
+  s21_exec_policy policies[3] = {{S21_EXEC_SEQUENTIAL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 4, NULL}};
+  for (int p = 0; p < 3; p++) {
+    memset(result, 0xff, sizeof(result));
+    ck_assert_int_eq(
+        s21_prefix_sum(values, result, COUNT, codes, &policies[p]), CodeOK);
+    for (int i = 0; i < COUNT; i++) {
+      ck_assert_int_eq(codes[i], CodeOK);
+      ck_assert_int_eq(s21_is_equal(result[i], expected[i]), 1);
+    }
+  }
+  // Смешанные scale и полноразрядные суммы: параллельный скан побитно
+  // совпадает с последовательным
+  static int expected_codes[COUNT];
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, values, COUNT);
+  int status = s21_prefix_sum(values, expected, COUNT, expected_codes, NULL);
+  ck_assert_int_eq(s21_prefix_sum(values, result, COUNT, codes, &policies[2]),
+                   status);
+  ck_assert_int_eq(memcmp(result, expected, sizeof(result)), 0);
+  ck_assert_int_eq(memcmp(codes, expected_codes, sizeof(codes)), 0);
+  ck_assert_int_eq(s21_prefix_sum(values, result, 0, NULL, NULL), CodeOK);
+  ck_assert_int_eq(s21_prefix_sum(NULL, result, 1, NULL, NULL),
+                   CodeInvalidData);
+  s21_pool_shutdown();
+}
+END_TEST
+
+// Переполнение отмечается у своего элемента, следующие суммы точные
+START_TEST(prefix_sum_overflow_per_element) {
+  s21_decimal max = {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0}};
+  s21_decimal values[6] = {max, {{1, 0, 0, 0}}, max, {{1, 0, 0, 0}},
+                           {{5, 0, 0, 0}}, {{3, 0, 0, 0x00010000}}};
+  s21_negate(max, &values[2]);
+  values[3].bits[3] = 29 << 16;
+  s21_decimal out[6];
+  int codes[6];
+  ck_assert_int_eq(s21_prefix_sum(values, out, 6, codes, NULL),
+                   CodeBigNumber);
+  int expected_codes[6] = {CodeOK, CodeBigNumber, CodeOK,
+                           CodeInvalidData, CodeOK, CodeOK};
+  unsigned int expected_low[6] = {0xFFFFFFFF, 0, 1, 0, 6, 63};
+  for (int i = 0; i < 6; i++) {
+    ck_assert_int_eq(codes[i], expected_codes[i]);
+    ck_assert_uint_eq(out[i].bits[0], expected_low[i]);
+  }
+  ck_assert_int_eq(get_scale(out[5]), 1);
+}
+END_TEST
+
+// push нового значения и evict самого старого дают то же состояние, что
+// и окно, собранное из оставшихся значений, включая scale сумм
+START_TEST(window_push_evict_restores_state) {
+  s21_decimal values[3] = {{{12345, 0, 0, 0x00050000}},
+                           {{7, 0, 0, 0x80000000}},
+                           {{250, 0, 0, 0x00010000}}};
+  s21_decimal weight = {{3, 0, 0, 0x00020000}};
+  s21_window window;
+  s21_window expected;
+  ck_assert_int_eq(s21_window_init(&window, 0), CodeOK);
+  ck_assert_int_eq(s21_window_init(&expected, 0), CodeOK);
+  for (int i = 0; i < 3; i++) {
+    ck_assert_int_eq(s21_window_push(&window, i, values[i], weight), CodeOK);
+  }
+  ck_assert_int_eq(s21_window_evict(&window), CodeOK);
+  for (int i = 1; i < 3; i++) {
+    ck_assert_int_eq(s21_window_push(&expected, i, values[i], weight), CodeOK);
+  }
+  ck_assert_int_eq(s21_window_count(&window), 2);
+  ck_assert_int_eq(memcmp(&window.values, &expected.values,
+                          sizeof(s21_window_total)),
+                   0);
+  ck_assert_int_eq(memcmp(&window.products, &expected.products,
+                          sizeof(s21_window_total)),
+                   0);
+  // Пустое окно возвращается к начальному состоянию
+  s21_window_reset(&expected);
+  ck_assert_int_eq(s21_window_evict_before(&window, 100), CodeOK);
+  ck_assert_int_eq(s21_window_count(&window), 0);
+  ck_assert_int_eq(memcmp(&window.values, &expected.values,
+                          sizeof(s21_window_total)),
+                   0);
+  ck_assert_int_eq(s21_window_evict(&window), CodeInvalidData);
+  s21_decimal result;
+  ck_assert_int_eq(s21_window_mean(&window, &result), CodeDivisionZero);
+  ck_assert_int_eq(s21_window_vwap(&window, &result), CodeDivisionZero);
+  ck_assert_int_eq(s21_window_sum(&window, &result), CodeOK);
+  ck_assert_int_eq(is_zero(result), 1);
+  s21_window_free(&window);
+  s21_window_free(&expected);
+}
+END_TEST
+
+// push и evict с ошибкой (переполнение суммы произведений после уже
+// посчитанных сумм значений и весов) не меняют окно
+START_TEST(window_failed_update_keeps_state) {
+  s21_decimal one = DEC(1, 0, 0, 0, 0);
+  s21_decimal minus_one = DEC(1, 0, 0, 0, 1);
+  for (size_t limit = 0; limit < 2; limit++) {
+    s21_window window;
+    ck_assert_int_eq(s21_window_init(&window, limit), CodeOK);
+    ck_assert_int_eq(s21_window_push(&window, 1, minus_one, one), CodeOK);
+    memset(window.products.sum.bits, 0xff, sizeof(window.products.sum.bits));
+    window.products.sum.sign = 0;
+    s21_window before = window;
+    ck_assert_int_ne(s21_window_push(&window, 2, one, one), CodeOK);
+    ck_assert_int_eq(memcmp(&window, &before, sizeof(s21_window)), 0);
+    // Уход -1 x 1 прибавляет 1 к сумме произведений
+    ck_assert_int_ne(s21_window_evict(&window), CodeOK);
+    ck_assert_int_eq(memcmp(&window, &before, sizeof(s21_window)), 0);
+    ck_assert_int_ne(s21_window_evict_before(&window, 10), CodeOK);
+    ck_assert_int_eq(s21_window_count(&window), 1);
+    s21_window_free(&window);
+  }
+}
+END_TEST
+
+// Окно по количеству совпадает с пересчетом окна через s21_add, s21_mul и
+// s21_div (цены и количества перемножаются без округления)
+START_TEST(window_matches_recompute) {
+  enum { COUNT = 300, LIMIT = 25 };
+  s21_decimal prices[COUNT];
+  s21_decimal quantities[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 21);
+  s21_workload_fill(&workload, S21_WORKLOAD_PRICE, prices, COUNT);
+  s21_workload_fill(&workload, S21_WORKLOAD_QUANTITY, quantities, COUNT);
+  s21_window window;
+  ck_assert_int_eq(s21_window_init(&window, LIMIT), CodeOK);
+  for (int i = 0; i < COUNT; i++) {
+    ck_assert_int_eq(s21_window_push(&window, i, prices[i], quantities[i]),
+                     CodeOK);
+    s21_decimal sum = {{0}};
+    s21_decimal volume = {{0}};
+    s21_decimal notional = {{0}};
+    for (int j = (i < LIMIT ? 0 : i - LIMIT + 1); j <= i; j++) {
+      s21_decimal product;
+      ck_assert_int_eq(s21_add(sum, prices[j], &sum), CodeOK);
+      ck_assert_int_eq(s21_add(volume, quantities[j], &volume), CodeOK);
+      ck_assert_int_eq(s21_mul(prices[j], quantities[j], &product), CodeOK);
+      ck_assert_int_eq(s21_add(notional, product, &notional), CodeOK);
+    }
+    s21_decimal count = {{s21_window_count(&window), 0, 0, 0}};
+    s21_decimal expected;
+    s21_decimal result;
+    ck_assert_int_eq(s21_window_sum(&window, &result), CodeOK);
+    ck_assert_int_eq(s21_is_equal(result, sum), 1);
+    ck_assert_int_eq(s21_div(sum, count, &expected), CodeOK);
+    ck_assert_int_eq(s21_window_mean(&window, &result), CodeOK);
+    ck_assert_int_eq(s21_is_equal(result, expected), 1);
+    ck_assert_int_eq(s21_div(notional, volume, &expected), CodeOK);
+    ck_assert_int_eq(s21_window_vwap(&window, &result), CodeOK);
+    ck_assert_int_eq(s21_is_equal(result, expected), 1);
+  }
+  ck_assert_int_eq(s21_window_count(&window), LIMIT);
+  s21_decimal invalid = {{1, 0, 0, 0x001D0000}};
+  ck_assert_int_eq(s21_window_push(&window, 0, invalid, quantities[0]),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_window_count(&window), LIMIT);
+  s21_window_free(&window);
+}
+END_TEST
+
+// (10.5 * 2 + 11 * 3 + 9.25 * 5) / 10 = 10.025, банковское округление до
+// 10.02. Разные scale идут мимо сложения по столбцам
+START_TEST(weighted_avg_single_rounding) {
+  s21_decimal values[3] = {{{105, 0, 0, 0x00010000}},
+                           {{11, 0, 0, 0}},
+                           {{925, 0, 0, 0x00020000}}};
+  s21_decimal weights[3] = {{{2, 0, 0, 0}}, {{3, 0, 0, 0}}, {{5, 0, 0, 0}}};
+  s21_decimal result;
+  ck_assert_int_eq(s21_weighted_avg_n(values, weights, 3, 2, &result, NULL),
+                   CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1002);
+  ck_assert_int_eq(get_scale(result), 2);
+  // Отрицательная сумма и многословные мантиссы при одном scale:
+  // (-2^32 * 1 + 2^64 * 2^32) / (1 + 2^32) = 2^64 - 2^32
+  s21_decimal wide_values[3] = {{{0, 1, 0, 0x80000000}},
+                                {{0, 0, 1, 0}},
+                                {{3, 0, 0, 0x80000000}}};
+  s21_decimal wide_weights[3] = {{{1, 0, 0, 0}}, {{0, 1, 0, 0}},
+                                 {{1, 0, 0, 0}}};
+  ck_assert_int_eq(
+      s21_weighted_avg_n(wide_values, wide_weights, 2, 0, &result, NULL),
+      CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0);
+  ck_assert_uint_eq(result.bits[1], 0xFFFFFFFF);
+  ck_assert_uint_eq(result.bits[2], 0);
+  // (-3 * 1 + 1 * 1) / 2 = -1
+  wide_values[1].bits[0] = 1;
+  wide_values[1].bits[2] = 0;
+  wide_weights[1].bits[1] = 0;
+  wide_weights[1].bits[0] = 1;
+  ck_assert_int_eq(s21_weighted_avg_n(&wide_values[1], &wide_weights[1], 2,
+                                      0, &result, NULL),
+                   CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1);
+  ck_assert_int_eq(get_sign(result), 1);
+  s21_decimal zero[2] = {{{1, 0, 0, 0}}, {{1, 0, 0, 0x80000000}}};
+  ck_assert_int_eq(s21_weighted_avg_n(values, zero, 2, 2, &result, NULL),
+                   CodeDivisionZero);
+  ck_assert_int_eq(s21_weighted_avg_n(values, weights, 0, 2, &result, NULL),
+                   CodeDivisionZero);
+  ck_assert_int_eq(s21_weighted_avg_n(values, weights, 3, 29, &result, NULL),
+                   CodeInvalidData);
+  // 100000000000 + 5.000000000025e-18 со scale 28 не помещается: одно
+  // округление до scale 17 дает ...00001, округление через scale 28 (до
+  // ровно половины) - ...00000
+  s21_decimal big_values[2] = {{{0xA94A2005, 0x1D1, 0, 0x00010000}},
+                               {{0x4876E800, 0x17, 0, 0}}};
+  s21_decimal big_weights[2] = {{{1, 0, 0, 0}},
+                                {{0x1FFFFFFF, 0x7C4A04C2, 0x409F9CBC, 0}}};
+  ck_assert_int_eq(
+      s21_weighted_avg_n(big_values, big_weights, 2, 28, &result, NULL),
+      CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0x10000001);
+  ck_assert_uint_eq(result.bits[1], 0x3E250261);
+  ck_assert_uint_eq(result.bits[2], 0x204FCE5E);
+  ck_assert_int_eq(get_scale(result), 17);
+}
+END_TEST
+
+// VWAP по сделкам совпадает с s21_div(скалярное произведение, объем),
+// округленным до того же scale, и не зависит от политики
+START_TEST(weighted_avg_matches_dot_and_policy) {
+  enum { COUNT = 40000 };
+  static s21_decimal prices[COUNT];
+  static s21_decimal quantities[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 8);
+  s21_workload_fill(&workload, S21_WORKLOAD_PRICE, prices, COUNT);
+  s21_workload_fill(&workload, S21_WORKLOAD_QUANTITY, quantities, COUNT);
+  s21_decimal notional;
+  s21_decimal volume;
+  s21_decimal expected;
+  ck_assert_int_eq(
+      s21_reduce_dot_parallel(prices, quantities, COUNT, NULL, &notional),
+      CodeOK);
+  ck_assert_int_eq(s21_reduce_sum_parallel(quantities, COUNT, NULL, &volume),
+                   CodeOK);
+  ck_assert_int_eq(s21_div(notional, volume, &expected), CodeOK);
+  ck_assert_int_eq(s21_rescale(expected, 6, S21_ROUND_HALF_EVEN, &expected),
+                   CodeOK);
+  s21_exec_policy parallel = {S21_EXEC_PARALLEL, 4, NULL};
+  s21_decimal sequential;
+  s21_decimal result;
+  ck_assert_int_eq(
+      s21_weighted_avg_n(prices, quantities, COUNT, 6, &sequential, NULL),
+      CodeOK);
+  ck_assert_int_eq(
+      s21_weighted_avg_n(prices, quantities, COUNT, 6, &result, &parallel),
+      CodeOK);
+  ck_assert_int_eq(memcmp(&result, &sequential, sizeof(result)), 0);
+  ck_assert_int_eq(memcmp(&result, &expected, sizeof(result)), 0);
+  s21_pool_shutdown();
+}
+END_TEST
+
+// x = {2, 4, 4, 4, 5, 5, 7, 9}: среднее 5, дисперсия 4 (выборочная 32 / 7),
+// отклонение 2; для y = 2x ковариация 8
+START_TEST(moments_known_values) {
+  int numbers[8] = {2, 4, 4, 4, 5, 5, 7, 9};
+  s21_moments moments;
+  s21_moments_init(&moments);
+  for (int i = 0; i < 8; i++) {
+    s21_decimal x = {{numbers[i], 0, 0, 0}};
+    s21_decimal y = {{2 * numbers[i], 0, 0, 0}};
+    ck_assert_int_eq(s21_moments_add(&moments, x, y), CodeOK);
+  }
+  s21_decimal result;
+  ck_assert_int_eq(s21_moments_mean(&moments, 2, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 500);
+  ck_assert_int_eq(s21_moments_variance(&moments, 0, 0, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 4);
+  ck_assert_int_eq(s21_moments_variance(&moments, 1, 4, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 45714);
+  ck_assert_int_eq(get_scale(result), 4);
+  ck_assert_int_eq(s21_moments_stddev(&moments, 0, 3, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 2000);
+  ck_assert_int_eq(s21_moments_covariance(&moments, 0, 1, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 80);
+  ck_assert_int_eq(s21_moments_stddev(&moments, 1, 29, &result),
+                   CodeInvalidData);
+  // Дисперсия меньше 10^-28: для {0, 2e-28} отклонение 1e-28, для
+  // {0, 3e-14} - ровно 1.5e-14 (дисперсия 2.25e-28 не округляется заранее)
+  s21_moments_init(&moments);
+  s21_decimal zero = {{0, 0, 0, 0}};
+  s21_decimal tiny = {{2, 0, 0, 28 << 16}};
+  s21_moments_add(&moments, zero, zero);
+  s21_moments_add(&moments, tiny, zero);
+  ck_assert_int_eq(s21_moments_stddev(&moments, 0, 28, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1);
+  ck_assert_int_eq(get_scale(result), 28);
+  s21_moments_init(&moments);
+  tiny.bits[0] = 3;
+  tiny.bits[3] = 14 << 16;
+  s21_moments_add(&moments, zero, zero);
+  s21_moments_add(&moments, tiny, zero);
+  ck_assert_int_eq(s21_moments_stddev(&moments, 0, 28, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0x98B76000);
+  ck_assert_uint_eq(result.bits[1], 0x886C);
+  ck_assert_int_eq(get_scale(result), 28);
+
+  s21_moments_init(&moments);
+  ck_assert_int_eq(s21_moments_mean(&moments, 2, &result), CodeDivisionZero);
+  s21_decimal one = {{1, 0, 0, 0}};
+  ck_assert_int_eq(s21_moments_add(&moments, one, one), CodeOK);
+  ck_assert_int_eq(s21_moments_variance(&moments, 1, 2, &result),
+                   CodeDivisionZero);
+}
+END_TEST
+
+// s21_moments_n по массиву (последовательно и на 4 потоках) дает те же
+// результаты, что и добавление по одной паре
+START_TEST(moments_n_matches_add_and_policy) {
+  enum { COUNT = 40000 };
+  static s21_decimal x[COUNT];
+  static s21_decimal y[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 17);
+  s21_workload_fill(&workload, S21_WORKLOAD_PNL, x, COUNT);
+  s21_workload_fill(&workload, S21_WORKLOAD_PRICE, y, COUNT);
+  for (int i = 0; i < COUNT; i += 1000) x[i].bits[1] = 77;
+  s21_moments expected;
+  s21_moments_init(&expected);
+  for (int i = 0; i < COUNT; i++) {
+    ck_assert_int_eq(s21_moments_add(&expected, x[i], y[i]), CodeOK);
+  }
+  s21_exec_policy policies[2] = {{S21_EXEC_SEQUENTIAL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 4, NULL}};
+  for (int p = 0; p < 2; p++) {
+    s21_moments moments;
+    ck_assert_int_eq(s21_moments_n(x, y, COUNT, &moments, &policies[p]),
+                     CodeOK);
+    ck_assert_uint_eq(moments.count, COUNT);
+    s21_decimal a;
+    s21_decimal b;
+    ck_assert_int_eq(s21_moments_mean(&expected, 10, &a), CodeOK);
+    ck_assert_int_eq(s21_moments_mean(&moments, 10, &b), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+    ck_assert_int_eq(s21_moments_variance(&expected, 1, 6, &a), CodeOK);
+    ck_assert_int_eq(s21_moments_variance(&moments, 1, 6, &b), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+    ck_assert_int_eq(s21_moments_covariance(&expected, 1, 6, &a), CodeOK);
+    ck_assert_int_eq(s21_moments_covariance(&moments, 1, 6, &b), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+    ck_assert_int_eq(s21_moments_n(x, NULL, COUNT, &moments, &policies[p]),
+                     CodeOK);
+    ck_assert_int_eq(s21_moments_stddev(&expected, 1, 4, &a), CodeOK);
+    ck_assert_int_eq(s21_moments_stddev(&moments, 1, 4, &b), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+    ck_assert_int_eq(s21_moments_covariance(&moments, 1, 4, &a), CodeOK);
+    ck_assert_int_eq(s21_moments_variance(&moments, 1, 4, &b), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+  }
+  s21_pool_shutdown();
+}
+END_TEST
+
+// Значение с индексом для эталонной сортировки: по величине, из равных -
+// по индексу
+typedef struct {
+  s21_decimal value;
+  size_t index;
+} select_item;
+
+static int select_item_compare(const void *a, const void *b) {
+  const select_item *x = a;
+  const select_item *y = b;
+  int order = s21_is_less(x->value, y->value)      ? -1
+              : s21_is_greater(x->value, y->value) ? 1
+                                                   : 0;
+  if (order == 0) order = (x->index < y->index) ? -1 : (x->index > y->index);
+  return order;
+}
+
+// Смешанные scale, знаки и равные значения в разной записи (1.5 и 1.50):
+// каждый ранг совпадает с отсортированной копией
+START_TEST(nth_element_matches_sort) {
+  enum { COUNT = 300 };
+  static s21_decimal values[COUNT];
+  static select_item items[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 23);
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, values, COUNT);
+  for (int i = 0; i < COUNT; i += 7) {
+    values[i] = (i % 2) ? (s21_decimal){{15, 0, 0, 1u << 16}}
+                        : (s21_decimal){{150, 0, 0, 2u << 16}};
+    if (i % 3 == 0) values[i].bits[3] |= 1u << 31;
+  }
+  values[5] = (s21_decimal){{0, 0, 0, 1u << 31}};
+  for (int i = 0; i < COUNT; i++) {
+    items[i].value = values[i];
+    items[i].index = (size_t)i;
+  }
+  qsort(items, COUNT, sizeof(select_item), select_item_compare);
+  for (int k = 0; k < COUNT; k++) {
+    s21_decimal result;
+    ck_assert_int_eq(s21_nth_element(values, COUNT, (size_t)k, &result, NULL),
+                     CodeOK);
+    ck_assert_int_eq(memcmp(&result, &items[k].value, sizeof(result)), 0);
+  }
+}
+END_TEST
+
+// {1, 2, 3.0, 4, 10}: медиана 3.0, 90-й процентиль 4 + 0.60 * 6 = 7.60,
+// 12.5-й - 1.500 (scale результата - точный, без нормализации); 0 и 100 -
+// минимум и максимум
+START_TEST(percentile_interpolates) {
+  s21_decimal values[5] = {{{4, 0, 0, 0}},
+                           {{10, 0, 0, 0}},
+                           {{1, 0, 0, 0}},
+                           {{30, 0, 0, 1u << 16}},
+                           {{2, 0, 0, 0}}};
+  s21_decimal result;
+  s21_decimal percent = {{50, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 30);
+  ck_assert_int_eq(get_scale(result), 1);
+  percent = (s21_decimal){{90, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 760);
+  ck_assert_int_eq(get_scale(result), 2);
+  percent = (s21_decimal){{125, 0, 0, 1u << 16}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1500);
+  ck_assert_int_eq(get_scale(result), 3);
+  percent = (s21_decimal){{0, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 1);
+  percent = (s21_decimal){{100, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 10);
+
+  percent = (s21_decimal){{101, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL),
+                   CodeInvalidData);
+  percent = (s21_decimal){{1, 0, 0, 1u << 31}};
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL),
+                   CodeInvalidData);
+  percent = (s21_decimal){{50, 0, 0, 0}};
+  ck_assert_int_eq(s21_percentile(values, 0, percent, &result, NULL),
+                   CodeInvalidData);
+  values[2].bits[3] = 29u << 16;
+  ck_assert_int_eq(s21_percentile(values, 5, percent, &result, NULL),
+                   CodeInvalidData);
+  ck_assert_int_eq(s21_nth_element(values, 5, 5, &result, NULL),
+                   CodeInvalidData);
+}
+END_TEST
+
+// Из равных значений (7 и 7.0) первым идет более ранний
+START_TEST(top_k_order_and_ties) {
+  s21_decimal values[6] = {{{7, 0, 0, 0}}, {{9, 0, 0, 1u << 31}},
+                           {{70, 0, 0, 1u << 16}},
+                           {{8, 0, 0, 0}}, {{1, 0, 0, 0}},
+                           {{7, 0, 0, 0}}};
+  s21_decimal out[4];
+  size_t indices[4];
+  ck_assert_int_eq(s21_top_k(values, 6, 4, out, indices, NULL), CodeOK);
+  size_t expected[4] = {3, 0, 2, 5};
+  for (int i = 0; i < 4; i++) {
+    ck_assert_uint_eq(indices[i], expected[i]);
+    ck_assert_int_eq(memcmp(&out[i], &values[expected[i]], sizeof(out[i])),
+                     0);
+  }
+  ck_assert_int_eq(s21_top_k(values, 6, 0, out, indices, NULL), CodeOK);
+  ck_assert_int_eq(s21_top_k(values, 6, 7, out, indices, NULL),
+                   CodeInvalidData);
+  values[4].bits[3] = 29u << 16;
+  ck_assert_int_eq(s21_top_k(values, 6, 2, out, NULL, NULL), CodeInvalidData);
+}
+END_TEST
+
+// Параллельные версии на массиве из нескольких блоков дают тот же ответ,
+// что и последовательные; top-K совпадает с началом сортировки по убыванию
+START_TEST(select_parallel_matches_sequential) {
+  enum { COUNT = 150000, TOP = 50 };
+  static s21_decimal values[COUNT];
+  static select_item items[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 29);
+  s21_workload_fill(&workload, S21_WORKLOAD_PNL, values, COUNT);
+  for (int i = 0; i < COUNT; i++) {
+    items[i].value = values[i];
+    items[i].index = (size_t)(COUNT - 1 - i);
+  }
+  qsort(items, COUNT, sizeof(select_item), select_item_compare);
+  s21_exec_policy policies[2] = {{S21_EXEC_SEQUENTIAL, 0, NULL},
+                                 {S21_EXEC_PARALLEL, 4, NULL}};
+  size_t ranks[4] = {0, 777, COUNT / 2, COUNT - 1};
+  for (int p = 0; p < 2; p++) {
+    for (int r = 0; r < 4; r++) {
+      s21_decimal result;
+      ck_assert_int_eq(
+          s21_nth_element(values, COUNT, ranks[r], &result, &policies[p]),
+          CodeOK);
+      ck_assert(s21_is_equal(result, items[ranks[r]].value));
+    }
+    s21_decimal percent = {{995, 0, 0, 1u << 16}};
+    s21_decimal a;
+    s21_decimal b;
+    ck_assert_int_eq(s21_percentile(values, COUNT, percent, &a, NULL),
+                     CodeOK);
+    ck_assert_int_eq(
+        s21_percentile(values, COUNT, percent, &b, &policies[p]), CodeOK);
+    ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+    s21_decimal out[TOP];
+    size_t indices[TOP];
+    ck_assert_int_eq(
+        s21_top_k(values, COUNT, TOP, out, indices, &policies[p]), CodeOK);
+    for (int i = 0; i < TOP; i++) {
+      // items отсортированы по возрастанию с обратными индексами: с конца
+      // идут наибольшие, из равных - с меньшим исходным индексом
+      select_item *item = &items[COUNT - 1 - i];
+      ck_assert_uint_eq(indices[i], COUNT - 1 - item->index);
+      ck_assert_int_eq(memcmp(&out[i], &item->value, sizeof(out[i])), 0);
+    }
+  }
+  s21_pool_shutdown();
+}
+END_TEST
+
+// n не кратно размеру выборки (4096): ранги у самого конца массива не
+// выводят место в выборке за ее границу
+START_TEST(select_parallel_ranks_near_end) {
+  enum { COUNT = 50 * 4096 + 4095 };
+  static s21_decimal values[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 31);
+  s21_workload_fill(&workload, S21_WORKLOAD_PRICE, values, COUNT);
+  s21_exec_policy policy = {S21_EXEC_PARALLEL, 4, NULL};
+  size_t ranks[4] = {COUNT - 1, COUNT - 2, COUNT - 64, COUNT - 4000};
+  for (int r = 0; r < 4; r++) {
+    s21_decimal expected;
+    s21_decimal result;
+    ck_assert_int_eq(s21_nth_element(values, COUNT, ranks[r], &expected, NULL),
+                     CodeOK);
+    ck_assert_int_eq(
+        s21_nth_element(values, COUNT, ranks[r], &result, &policy), CodeOK);
+    ck_assert_int_eq(memcmp(&result, &expected, sizeof(result)), 0);
+  }
+  s21_pool_shutdown();
+}
+END_TEST
+
+// Ключи int64 с отрицательными и INT64_MIN: группы в порядке первого
+// появления, точные суммы при разных scale и одно округление при чтении
+START_TEST(group_by_i64_aggregates) {
+  int64_t keys[8] = {7, -3, 7, INT64_MIN, -3, 7, 7, INT64_MIN};
+  s21_decimal values[8] = {{{150, 0, 0, 2u << 16}},
+                           {{5, 0, 0, 1u << 31}},
+                           {{15, 0, 0, 1u << 16}},
+                           {{1, 0, 0, 0}},
+                           {{2, 0, 0, 0}},
+                           {{1, 0, 0, 3u << 16 | 1u << 31}},
+                           {{UINT32_MAX - 5, UINT32_MAX, UINT32_MAX, 0}},
+                           {{UINT32_MAX, UINT32_MAX, UINT32_MAX, 0}}};
+  s21_group_table table;
+  ck_assert_int_eq(s21_group_by_i64(keys, values, 8, &table, NULL), CodeOK);
+  ck_assert_uint_eq(table.count, 3);
+  ck_assert_uint_eq(table.groups[0].key.bits[0], 7);
+  ck_assert_uint_eq(table.groups[1].key.bits[0], 3);
+  ck_assert_uint_eq(table.groups[1].key.bits[3], 1u << 31);
+  ck_assert_uint_eq(table.groups[2].key.bits[1], 1u << 31);
+  ck_assert_uint_eq(table.groups[0].count, 4);
+  ck_assert_uint_eq(table.groups[0].first, 0);
+  ck_assert_uint_eq(table.groups[2].first, 3);
+  // min группы 7 - -0.001, max - 2^96 - 6
+  const s21_group *group = &table.groups[0];
+  ck_assert_int_eq(memcmp(&group->min, &values[5], sizeof(s21_decimal)), 0);
+  ck_assert_int_eq(memcmp(&group->max, &values[6], sizeof(s21_decimal)), 0);
+  s21_decimal result;
+  // 1.50 + 1.5 - 0.001 + (2^96 - 6) = 2^96 - 3.001: точная сумма
+  // округляется один раз
+  ck_assert_int_eq(s21_group_sum(group, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], UINT32_MAX - 2);
+  ck_assert_uint_eq(result.bits[1], UINT32_MAX);
+  ck_assert_uint_eq(result.bits[2], UINT32_MAX);
+  ck_assert_int_eq(get_scale(result), 0);
+  // Среднее (2^96 - 3.001) / 4 со scale 28 не помещается: одно деление
+  // со scale 0 дает 2^94 - 1
+  ck_assert_int_eq(s21_group_avg(group, 28, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], UINT32_MAX);
+  ck_assert_uint_eq(result.bits[1], UINT32_MAX);
+  ck_assert_uint_eq(result.bits[2], UINT32_MAX >> 2);
+  ck_assert_int_eq(get_scale(result), 0);
+  ck_assert_int_eq(s21_group_sum(&table.groups[1], &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 3);
+  ck_assert_uint_eq(result.bits[3], 1u << 31);
+  ck_assert_int_eq(s21_group_avg(&table.groups[1], 2, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 150);
+  ck_assert_uint_eq(result.bits[3], 2u << 16 | 1u << 31);
+  ck_assert_int_eq(s21_group_sum(&table.groups[2], &result), CodeBigNumber);
+  // (1 + 2^96 - 1) / 2 = 2^95
+  ck_assert_int_eq(s21_group_avg(&table.groups[2], 0, &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 0);
+  ck_assert_uint_eq(result.bits[1], 0);
+  ck_assert_uint_eq(result.bits[2], 1u << 31);
+  ck_assert_int_eq(s21_group_avg(&table.groups[2], 29, &result),
+                   CodeInvalidData);
+  s21_group_table_free(&table);
+  ck_assert_ptr_null(table.groups);
+
+  ck_assert_int_eq(s21_group_by_i64(keys, values, 0, &table, NULL), CodeOK);
+  ck_assert_uint_eq(table.count, 0);
+  s21_group_table_free(&table);
+}
+END_TEST
+
+// Decimal-ключи 1.5, 1.50 и 15E-1 - одна группа, -0 и 0.00 - одна; строки
+// с недопустимым scale пропускаются с CodeInvalidData
+START_TEST(group_by_decimal_keys) {
+  s21_decimal keys[6] = {{{15, 0, 0, 1u << 16}},
+                         {{0, 0, 0, 1u << 31}},
+                         {{150, 0, 0, 2u << 16}},
+                         {{0, 0, 0, 2u << 16}},
+                         {{1, 0, 0, 29u << 16}},
+                         {{1500, 0, 0, 3u << 16}}};
+  s21_decimal values[6] = {{{1, 0, 0, 0}}, {{2, 0, 0, 0}}, {{3, 0, 0, 0}},
+                           {{4, 0, 0, 0}}, {{5, 0, 0, 0}}, {{6, 0, 0, 0}}};
+  values[5].bits[3] = 29u << 16;
+  s21_group_table table;
+  ck_assert_int_eq(s21_group_by_decimal(keys, values, 6, &table, NULL),
+                   CodeInvalidData);
+  ck_assert_uint_eq(table.count, 2);
+  ck_assert_uint_eq(table.groups[0].key.bits[0], 15);
+  ck_assert_int_eq(get_scale(table.groups[0].key), 1);
+  ck_assert_uint_eq(table.groups[0].count, 2);
+  ck_assert_uint_eq(table.groups[1].key.bits[3], 0);
+  ck_assert_uint_eq(table.groups[1].count, 2);
+  s21_decimal result;
+  ck_assert_int_eq(s21_group_sum(&table.groups[1], &result), CodeOK);
+  ck_assert_uint_eq(result.bits[0], 6);
+  s21_group_table_free(&table);
+  ck_assert_int_eq(s21_group_by_decimal(NULL, values, 6, &table, NULL),
+                   CodeInvalidData);
+}
+END_TEST
+
+// Разбиение на разделы дает те же группы побитно: порядок, количества,
+// min, max и суммы при разных числах групп
+START_TEST(group_by_partitioned_matches_sequential) {
+  enum { COUNT = 300000 };
+  static int64_t keys[COUNT];
+  static s21_decimal values[COUNT];
+  s21_workload workload;
+  s21_workload_init(&workload, 31);
+  s21_workload_fill(&workload, S21_WORKLOAD_MIXED, values, COUNT);
+  int64_t cardinalities[3] = {10, 5000, 200000};
+  s21_exec_policy policy = {S21_EXEC_PARALLEL, 4, NULL};
+  for (int c = 0; c < 3; c++) {
+    uint64_t state = 77;
+    for (int i = 0; i < COUNT; i++) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      keys[i] = (int64_t)((state >> 33) % (uint64_t)cardinalities[c]) - 3;
+    }
+    s21_group_table expected;
+    s21_group_table table;
+    ck_assert_int_eq(s21_group_by_i64(keys, values, COUNT, &expected, NULL),
+                     CodeOK);
+    ck_assert_int_eq(s21_group_by_i64(keys, values, COUNT, &table, &policy),
+                     CodeOK);
+    ck_assert_uint_eq(table.count, expected.count);
+    size_t rows = 0;
+    for (size_t g = 0; g < table.count; g++) {
+      const s21_group *a = &expected.groups[g];
+      const s21_group *b = &table.groups[g];
+      ck_assert_int_eq(memcmp(&a->key, &b->key, sizeof(s21_decimal)), 0);
+      ck_assert_uint_eq(a->count, b->count);
+      ck_assert_uint_eq(a->first, b->first);
+      ck_assert_int_eq(memcmp(&a->min, &b->min, sizeof(s21_decimal)), 0);
+      ck_assert_int_eq(memcmp(&a->max, &b->max, sizeof(s21_decimal)), 0);
+      s21_decimal x;
+      s21_decimal y;
+      int code = s21_group_sum(a, &x);
+      ck_assert_int_eq(s21_group_sum(b, &y), code);
+      if (code == CodeOK) ck_assert_int_eq(memcmp(&x, &y, sizeof(x)), 0);
+      rows += b->count;
+    }
+    ck_assert_uint_eq(rows, COUNT);
+    s21_group_table_free(&expected);
+    s21_group_table_free(&table);
+  }
+  s21_pool_shutdown();
+}
+END_TEST
+
 Suite *pack_suite() {
   Suite *s;
   s = suite_create("Decimal functions tests");
@@ -2138,6 +3959,155 @@ Suite *pack_suite() {
   tcase_add_test(tc_bonus, add_trigger_add_one_to_mantissa);
   suite_add_tcase(s, tc_bonus);
 
+  TCase *tc_mixed_int = tcase_create("s21_i64");
+  tcase_add_test(tc_mixed_int, add_i64_scale);
+  tcase_add_test(tc_mixed_int, sub_i64_min);
+  tcase_add_test(tc_mixed_int, add_i64_matches_add_on_overflow);
+  tcase_add_test(tc_mixed_int, mul_i64_negative);
+  tcase_add_test(tc_mixed_int, mul_i64_overflow);
+  tcase_add_test(tc_mixed_int, div_i64_matches_div);
+  tcase_add_test(tc_mixed_int, div_i64_cases);
+  tcase_add_test(tc_mixed_int, mul_i64_batch);
+  suite_add_tcase(s, tc_mixed_int);
+
+  TCase *tc_rescale = tcase_create("s21_rescale");
+  tcase_add_test(tc_rescale, rescale_half_modes);
+  tcase_add_test(tc_rescale, rescale_directed_modes);
+  tcase_add_test(tc_rescale, rescale_up);
+  tcase_add_test(tc_rescale, ceil_cases);
+  suite_add_tcase(s, tc_rescale);
+
+  TCase *tc_quantize = tcase_create("s21_quantize_n");
+  tcase_add_test(tc_quantize, quantize_usd);
+  tcase_add_test(tc_quantize, quantize_overflow);
+  tcase_add_test(tc_quantize, quantize_matches_rescale);
+  suite_add_tcase(s, tc_quantize);
+
+  TCase *tc_digits = tcase_create("s21_digits");
+  tcase_add_test(tc_digits, digit_count_cases);
+  tcase_add_test(tc_digits, trailing_zeros_cases);
+  tcase_add_test(tc_digits, normalize_limits_by_scale);
+  tcase_add_test(tc_digits, align_partial_raise);
+  suite_add_tcase(s, tc_digits);
+
+
+  TCase *tc_pow = tcase_create("s21_pow");
+  tcase_add_test(tc_pow, pow_exact);
+  tcase_add_test(tc_pow, pow_long_chain);
+  tcase_add_test(tc_pow, pow_negative_exponent);
+  tcase_add_test(tc_pow, pow_errors);
+  tcase_add_test(tc_pow, compound_batch);
+  suite_add_tcase(s, tc_pow);
+
+
+  TCase *tc_transcendental = tcase_create("s21_transcendental");
+  tcase_add_test(tc_transcendental, sqrt_cases);
+  tcase_add_test(tc_transcendental, exp_cases);
+  tcase_add_test(tc_transcendental, ln_cases);
+  tcase_add_test(tc_transcendental, log10_cases);
+  tcase_add_test(tc_transcendental, transcendental_batch);
+  suite_add_tcase(s, tc_transcendental);
+
+
+  TCase *tc_workload = tcase_create("s21_workload");
+  tcase_add_test(tc_workload, workload_deterministic);
+  tcase_add_test(tc_workload, workload_kinds);
+  tcase_add_test(tc_workload, workload_trace_roundtrip);
+  tcase_add_test(tc_workload, workload_replay_results);
+  suite_add_tcase(s, tc_workload);
+
+
+  TCase *tc_stats = tcase_create("s21_stats");
+  tcase_add_test(tc_stats, stats_names);
+  tcase_add_test(tc_stats, stats_slow_paths);
+  tcase_add_test(tc_stats, stats_reset_clears);
+  suite_add_tcase(s, tc_stats);
+
+
+  TCase *tc_latency = tcase_create("s21_latency");
+  tcase_add_test(tc_latency, latency_percentiles);
+  tcase_add_test(tc_latency, latency_names);
+  tcase_add_test(tc_latency, latency_sampling);
+  suite_add_tcase(s, tc_latency);
+
+
+  TCase *tc_inline = tcase_create("s21_decimal_inline");
+  tcase_add_test(tc_inline, inline_matches_extern);
+  tcase_add_test(tc_inline, inline_setters_match_extern);
+  suite_add_tcase(s, tc_inline);
+
+
+  TCase *tc_ref = tcase_create("s21_ref_assign");
+  tcase_add_test(tc_ref, ref_matches_by_value);
+  tcase_add_test(tc_ref, assign_accumulates);
+  tcase_add_test(tc_ref, assign_keeps_acc_on_error);
+  suite_add_tcase(s, tc_ref);
+
+
+  TCase *tc_atomic = tcase_create("s21_atomic");
+  tcase_add_test(tc_atomic, atomic_single_thread);
+  tcase_add_test(tc_atomic, atomic_matches_add);
+  tcase_add_test(tc_atomic, atomic_threads_exact);
+  suite_add_tcase(s, tc_atomic);
+
+
+  TCase *tc_sharded = tcase_create("s21_sharded_sum");
+  tcase_add_test(tc_sharded, sharded_single_rounding);
+  tcase_add_test(tc_sharded, sharded_errors_and_reset);
+  tcase_add_test(tc_sharded, sharded_threads_exact);
+  suite_add_tcase(s, tc_sharded);
+
+
+  TCase *tc_reduce = tcase_create("s21_reduce_parallel");
+  tcase_add_test(tc_reduce, reduce_sum_independent_of_threads);
+  tcase_add_test(tc_reduce, reduce_sum_single_rounding);
+  tcase_add_test(tc_reduce, reduce_min_max_dot);
+  suite_add_tcase(s, tc_reduce);
+
+  TCase *tc_exec = tcase_create("s21_exec_policy");
+  tcase_add_test(tc_exec, exec_for_covers_each_index_once);
+  tcase_add_test(tc_exec, batch_parallel_matches_sequential);
+  suite_add_tcase(s, tc_exec);
+
+
+  TCase *tc_prefix = tcase_create("s21_prefix_sum");
+  tcase_add_test(tc_prefix, prefix_sum_matches_add_chain);
+  tcase_add_test(tc_prefix, prefix_sum_overflow_per_element);
+  suite_add_tcase(s, tc_prefix);
+
+
+  TCase *tc_window = tcase_create("s21_window");
+  tcase_add_test(tc_window, window_push_evict_restores_state);
+  tcase_add_test(tc_window, window_failed_update_keeps_state);
+  tcase_add_test(tc_window, window_matches_recompute);
+  suite_add_tcase(s, tc_window);
+
+
+  TCase *tc_weighted = tcase_create("s21_weighted_avg_n");
+  tcase_add_test(tc_weighted, weighted_avg_single_rounding);
+  tcase_add_test(tc_weighted, weighted_avg_matches_dot_and_policy);
+  suite_add_tcase(s, tc_weighted);
+
+
+  TCase *tc_moments = tcase_create("s21_moments");
+  tcase_add_test(tc_moments, moments_known_values);
+  tcase_add_test(tc_moments, moments_n_matches_add_and_policy);
+  suite_add_tcase(s, tc_moments);
+
+  TCase *tc_select = tcase_create("s21_select");
+  tcase_add_test(tc_select, nth_element_matches_sort);
+  tcase_add_test(tc_select, percentile_interpolates);
+  tcase_add_test(tc_select, top_k_order_and_ties);
+  tcase_add_test(tc_select, select_parallel_matches_sequential);
+  tcase_add_test(tc_select, select_parallel_ranks_near_end);
+  suite_add_tcase(s, tc_select);
+
+  TCase *tc_group = tcase_create("s21_group_by");
+  tcase_add_test(tc_group, group_by_i64_aggregates);
+  tcase_add_test(tc_group, group_by_decimal_keys);
+  tcase_add_test(tc_group, group_by_partitioned_matches_sequential);
+  suite_add_tcase(s, tc_group);
+
   return s;
 }
 